@@ -23,6 +23,9 @@ constexpr auto kSendMySpeakingInterval = 3 * crl::time(1000);
 constexpr auto kSendMyTypingInterval = 5 * crl::time(1000);
 constexpr auto kSendTypingsToOfflineFor = TimeId(30);
 
+// Typing actions may wait a bit to go in one container with others.
+constexpr auto kSendActionCanWait = crl::time(100);
+
 } // namespace
 
 SendProgressManager::SendProgressManager(not_null<Main::Session*> session)
@@ -142,7 +145,7 @@ void SendProgressManager::send(const Key &key, int progress) {
 		action
 	)).done([=](const MTPBool &result, mtpRequestId requestId) {
 		done(result, requestId);
-	}).send();
+	}).afterDelay(kSendActionCanWait).send();
 	_requests.emplace(key, requestId);
 
 	if (key.type == Type::Typing) {
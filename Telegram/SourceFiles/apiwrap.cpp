@@ -106,17 +106,55 @@ constexpr auto kUnreadMentionsPreloadIfLess = 5;
 constexpr auto kUnreadMentionsFirstRequestLimit = 10;
 constexpr auto kUnreadMentionsNextRequestLimit = 100;
 constexpr auto kSharedMediaLimit = 100;
+constexpr auto kSharedMediaCountsDelay = crl::time(20);
 constexpr auto kReadFeaturedSetsTimeout = crl::time(1000);
 constexpr auto kFileLoaderQueueStopTimeout = crl::time(5000);
 constexpr auto kStickersByEmojiInvalidateTimeout = crl::time(6 * 1000);
 constexpr auto kNotifySettingSaveTimeout = crl::time(1000);
 constexpr auto kDialogsFirstLoad = 20;
 constexpr auto kDialogsPerPage = 500;
+constexpr auto kChannelParticipantsPagesLimit = 64;
 
 using PhotoFileLocationId = Data::PhotoFileLocationId;
 using DocumentFileLocationId = Data::DocumentFileLocationId;
 using UpdatedFileReferences = Data::UpdatedFileReferences;
 
+[[nodiscard]] BareId ParticipantBareId(
+		const MTPChannelParticipant &participant) {
+	const auto peerId = participant.match([](
+			const MTPDchannelParticipantBanned &data) {
+		return peerFromMTP(data.vpeer());
+	}, [](const MTPDchannelParticipantLeft &data) {
+		return peerFromMTP(data.vpeer());
+	}, [](const auto &data) {
+		return peerFromUser(data.vuser_id());
+	});
+	return peerIsUser(peerId)
+		? peerToUser(peerId).bare
+		: peerIsChat(peerId)
+		? peerToChat(peerId).bare
+		: peerToChannel(peerId).bare;
+}
+
+[[nodiscard]] QString ParticipantsFilterQuery(
+		const MTPChannelParticipantsFilter &filter) {
+	return filter.match([](const MTPDchannelParticipantsKicked &data) {
+		return qs(data.vq());
+	}, [](const MTPDchannelParticipantsBanned &data) {
+		return qs(data.vq());
+	}, [](const MTPDchannelParticipantsSearch &data) {
+		return qs(data.vq());
+	}, [](const MTPDchannelParticipantsContacts &data) {
+		return qs(data.vq());
+	}, [](const MTPDchannelParticipantsMentions &data) {
+		return QString::number(data.vtop_msg_id().value_or_empty())
+			+ ':'
+			+ qs(data.vq().value_or_empty());
+	}, [](const auto &) {
+		return QString();
+	});
+}
+
 [[nodiscard]] TimeId UnixtimeFromMsgId(mtpMsgId msgId) {
 	return TimeId(msgId >> 32);
 }
@@ -130,6 +168,7 @@ ApiWrap::ApiWrap(not_null<Main::Session*> session)
 , _webPagesTimer([=] { resolveWebPages(); })
 , _draftsSaveTimer([=] { saveDraftsToCloud(); })
 , _featuredSetsReadTimer([=] { readFeaturedSets(); })
+, _sharedMediaCountsTimer([=] { requestSharedMediaCounts(); })
 , _dialogsLoadState(std::make_unique<DialogsLoadState>())
 , _fileLoader(std::make_unique<TaskQueue>(kFileLoaderQueueStopTimeout))
 , _topPromotionTimer([=] { refreshTopPromotion(); })
@@ -3219,6 +3258,67 @@ void ApiWrap::parseChannelParticipants(
 	});
 }
 
+uint64 ApiWrap::channelParticipantsHash(
+		not_null<ChannelData*> channel,
+		const MTPChannelParticipantsFilter &filter,
+		int offset,
+		int limit) const {
+	const auto i = _channelParticipantsPages.find(std::make_tuple(
+		channel,
+		filter.type(),
+		ParticipantsFilterQuery(filter),
+		offset,
+		limit));
+	if (i == end(_channelParticipantsPages)) {
+		return 0;
+	}
+	return i->second.match([](const MTPDchannels_channelParticipants &data) {
+		return Api::CountHash(ranges::views::all(
+			data.vparticipants().v
+		) | ranges::views::transform(ParticipantBareId));
+	}, [](const MTPDchannels_channelParticipantsNotModified &) {
+		return uint64(0);
+	});
+}
+
+MTPchannels_ChannelParticipants ApiWrap::channelParticipantsReceived(
+		not_null<ChannelData*> channel,
+		const MTPChannelParticipantsFilter &filter,
+		int offset,
+		int limit,
+		const MTPchannels_ChannelParticipants &result) {
+	auto key = std::make_tuple(
+		channel,
+		filter.type(),
+		ParticipantsFilterQuery(filter),
+		offset,
+		limit);
+	if (result.type() == mtpc_channels_channelParticipantsNotModified) {
+		const auto i = _channelParticipantsPages.find(key);
+		return (i != end(_channelParticipantsPages)) ? i->second : result;
+	}
+	auto &order = _channelParticipantsPagesOrder;
+	const auto i = ranges::find(order, key);
+	if (i != end(order)) {
+		order.erase(i);
+	} else if (order.size() >= kChannelParticipantsPagesLimit) {
+		_channelParticipantsPages.remove(order.front());
+		order.erase(begin(order));
+	}
+	order.push_back(key);
+
+	// Keep only the participants, so that a replayed page won't overwrite
+	// the users with stale data, they're in the session data already.
+	const auto &data = result.c_channels_channelParticipants();
+	_channelParticipantsPages[std::move(key)]
+		= MTP_channels_channelParticipants(
+			data.vcount(),
+			data.vparticipants(),
+			MTP_vector<MTPChat>(),
+			MTP_vector<MTPUser>());
+	return result;
+}
+
 void ApiWrap::refreshChannelAdmins(
 		not_null<ChannelData*> channel,
 		const QVector<MTPChannelParticipant> &participants) {
@@ -3479,11 +3579,32 @@ void ApiWrap::requestSharedMedia(
 		SharedMediaType type,
 		MsgId messageId,
 		SliceType slice) {
+	if (!messageId) {
+		// Count-only requests don't depend on the direction.
+		slice = SliceType::Before;
+	}
 	const auto key = std::make_tuple(peer, type, messageId, slice);
 	if (_sharedMediaRequests.contains(key)) {
 		return;
+	} else if (!messageId) {
+		const auto filter = Api::PrepareSearchFilter(type);
+		if (filter.type() == mtpc_inputMessagesFilterEmpty) {
+			return;
+		}
+		_sharedMediaCountsToRequest[peer].emplace(type);
+		_sharedMediaCountsTimer.callOnce(kSharedMediaCountsDelay);
+		_sharedMediaRequests.emplace(key);
+		return;
 	}
+	sendSharedMediaRequest(peer, type, messageId, slice);
+}
 
+void ApiWrap::sendSharedMediaRequest(
+		not_null<PeerData*> peer,
+		SharedMediaType type,
+		MsgId messageId,
+		SliceType slice) {
+	const auto key = std::make_tuple(peer, type, messageId, slice);
 	const auto prepared = Api::PrepareSearchRequest(
 		peer,
 		type,
@@ -3513,6 +3634,68 @@ void ApiWrap::requestSharedMedia(
 	_sharedMediaRequests.emplace(key);
 }
 
+void ApiWrap::requestSharedMediaCounts() {
+	auto requests = base::take(_sharedMediaCountsToRequest);
+	for (auto &[peer, types] : requests) {
+		requestSharedMediaCounts(peer, std::move(types));
+	}
+}
+
+void ApiWrap::requestSharedMediaCounts(
+		not_null<PeerData*> peer,
+		base::flat_set<SharedMediaType> types) {
+	auto filters = QVector<MTPMessagesFilter>();
+	filters.reserve(types.size());
+	for (const auto type : types) {
+		filters.push_back(Api::PrepareSearchFilter(type));
+	}
+	const auto finishTypes = [=] {
+		for (const auto type : types) {
+			_sharedMediaRequests.remove(
+				std::make_tuple(peer, type, MsgId(0), SliceType::Before));
+		}
+	};
+
+	const auto history = _session->data().history(peer);
+	auto &histories = history->owner().histories();
+	const auto requestType = Data::Histories::RequestType::History;
+	histories.sendRequest(history, requestType, [=](Fn<void()> finish) {
+		return request(MTPmessages_GetSearchCounters(
+			peer->input,
+			MTP_vector<MTPMessagesFilter>(filters)
+		)).done([=](const MTPVector<MTPmessages_SearchCounter> &result) {
+			finishTypes();
+			for (const auto &counter : result.v) {
+				const auto &data = counter.c_messages_searchCounter();
+				const auto filter = data.vfilter().type();
+				for (const auto type : types) {
+					if (Api::PrepareSearchFilter(type).type() != filter) {
+						continue;
+					} else if (data.is_inexact()) {
+						// Don't show an approximate count, ask for the exact.
+						sendSharedMediaRequest(
+							peer,
+							type,
+							MsgId(0),
+							SliceType::Before);
+						continue;
+					}
+					_session->storage().add(Storage::SharedMediaAddSlice(
+						peer->id,
+						type,
+						{},
+						MsgRange(),
+						data.vcount().v));
+				}
+			}
+			finish();
+		}).fail([=](const MTP::Error &error) {
+			finishTypes();
+			finish();
+		}).send();
+	});
+}
+
 void ApiWrap::sharedMediaDone(
 		not_null<PeerData*> peer,
 		SharedMediaType type,
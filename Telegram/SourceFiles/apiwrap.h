@@ -310,6 +310,17 @@ public:
 			int availableCount,
 			const QVector<MTPChannelParticipant> &list)> callbackList = nullptr,
 		Fn<void()> callbackNotModified = nullptr);
+	[[nodiscard]] uint64 channelParticipantsHash(
+		not_null<ChannelData*> channel,
+		const MTPChannelParticipantsFilter &filter,
+		int offset,
+		int limit) const;
+	[[nodiscard]] MTPchannels_ChannelParticipants channelParticipantsReceived(
+		not_null<ChannelData*> channel,
+		const MTPChannelParticipantsFilter &filter,
+		int offset,
+		int limit,
+		const MTPchannels_ChannelParticipants &result);
 	void addChatParticipants(
 		not_null<PeerData*> peer,
 		const std::vector<not_null<UserData*>> &users,
@@ -512,6 +523,15 @@ private:
 		const QDate &date,
 		Callback &&callback);
 
+	void sendSharedMediaRequest(
+		not_null<PeerData*> peer,
+		SharedMediaType type,
+		MsgId messageId,
+		SliceType slice);
+	void requestSharedMediaCounts();
+	void requestSharedMediaCounts(
+		not_null<PeerData*> peer,
+		base::flat_set<SharedMediaType> types);
 	void sharedMediaDone(
 		not_null<PeerData*> peer,
 		SharedMediaType type,
@@ -601,6 +621,16 @@ private:
 	PeerRequests _botsRequests;
 	PeerRequests _adminsRequests;
 	base::DelayedCallTimer _participantsCountRequestTimer;
+	using ChannelParticipantsPageKey = std::tuple<
+		not_null<ChannelData*>,
+		mtpTypeId,
+		QString,
+		int,
+		int>;
+	base::flat_map<
+		ChannelParticipantsPageKey,
+		MTPchannels_ChannelParticipants> _channelParticipantsPages;
+	std::vector<ChannelParticipantsPageKey> _channelParticipantsPagesOrder;
 
 	ChannelData *_channelMembersForAdd = nullptr;
 	mtpRequestId _channelMembersForAddRequestId = 0;
@@ -657,6 +687,10 @@ private:
 		SharedMediaType,
 		MsgId,
 		SliceType>> _sharedMediaRequests;
+	base::flat_map<
+		not_null<PeerData*>,
+		base::flat_set<SharedMediaType>> _sharedMediaCountsToRequest;
+	base::Timer _sharedMediaCountsTimer;
 
 	base::flat_map<not_null<UserData*>, mtpRequestId> _userPhotosRequests;
 
@@ -537,6 +537,10 @@ std::shared_ptr<Data::CloudImageView> &PeerListRow::ensureUserpicView() {
 	return _userpic;
 }
 
+void PeerListRow::releaseUserpicView() {
+	_userpic = nullptr;
+}
+
 PaintRoundImageCallback PeerListRow::generatePaintUserpicCallback() {
 	const auto saved = _isSavedMessagesChat;
 	const auto replies = _isRepliesMessagesChat;
@@ -1645,6 +1649,41 @@ void PeerListContent::loadProfilePhotos() {
 	}
 }
 
+void PeerListContent::releaseHiddenUserpicViews() {
+	const auto rowsCount = shownRowsCount();
+	if (_visibleTop >= _visibleBottom || !rowsCount) {
+		return;
+	}
+
+	// Keep userpics only for the visible rows and the preload margins,
+	// so that scrolling through huge lists doesn't hold all of them.
+	const auto preload = (_visibleBottom - _visibleTop) * PreloadHeightsCount;
+	const auto top = rowsTop();
+	const auto from = std::clamp(
+		(_visibleTop - top - preload) / _rowHeight,
+		0,
+		rowsCount);
+	const auto till = std::clamp(
+		(_visibleBottom - top + preload) / _rowHeight + 1,
+		from,
+		rowsCount);
+	auto kept = base::flat_set<PeerListRowId>();
+	for (auto index = from; index != till; ++index) {
+		const auto row = getRow(RowIndex(index));
+		if (!row->special()) {
+			kept.emplace(row->id());
+		}
+	}
+	for (const auto id : _rowsWithUserpicViews) {
+		if (!kept.contains(id)) {
+			if (const auto row = findRow(id)) {
+				row->releaseUserpicView();
+			}
+		}
+	}
+	_rowsWithUserpicViews = std::move(kept);
+}
+
 void PeerListContent::checkScrollForPreload() {
 	if (_visibleBottom + PreloadHeightsCount * (_visibleBottom - _visibleTop) >= height()) {
 		_controller->loadMoreRows();
@@ -1787,6 +1826,7 @@ void PeerListContent::visibleTopBottomUpdated(
 	_visibleTop = visibleTop;
 	_visibleBottom = visibleBottom;
 	loadProfilePhotos();
+	releaseHiddenUserpicViews();
 	checkScrollForPreload();
 }
 
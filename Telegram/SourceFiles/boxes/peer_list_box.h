@@ -83,6 +83,7 @@ public:
 	}
 
 	[[nodiscard]] std::shared_ptr<Data::CloudImageView> &ensureUserpicView();
+	void releaseUserpicView();
 
 	[[nodiscard]] virtual QString generateName();
 	[[nodiscard]] virtual QString generateShortName();
@@ -683,6 +684,7 @@ private:
 
 	void selectByMouse(QPoint globalPosition);
 	void loadProfilePhotos();
+	void releaseHiddenUserpicViews();
 	void checkScrollForPreload();
 
 	void updateRow(not_null<PeerListRow*> row, RowIndex hint);
@@ -746,6 +748,7 @@ private:
 
 	std::vector<std::unique_ptr<PeerListRow>> _rows;
 	std::map<PeerListRowId, not_null<PeerListRow*>> _rowsById;
+	base::flat_set<PeerListRowId> _rowsWithUserpicViews;
 	std::map<PeerData*, std::vector<not_null<PeerListRow*>>> _rowsByPeer;
 
 	std::map<QChar, std::vector<not_null<PeerListRow*>>> _searchIndex;
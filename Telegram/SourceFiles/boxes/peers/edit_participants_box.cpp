@@ -1309,31 +1309,50 @@ void ParticipantsBoxController::loadMoreRows() {
 	const auto perPage = (_offset > 0)
 		? kParticipantsPerPage
 		: kParticipantsFirstPageCount;
-	const auto participantsHash = uint64(0);
+	const auto offset = _offset;
+	const auto participantsHash = [&] {
+		auto &api = channel->session().api();
+		return api.channelParticipantsHash(channel, filter, offset, perPage);
+	}();
 
 	_loadRequestId = _api.request(MTPchannels_GetParticipants(
 		channel->inputChannel,
 		filter,
-		MTP_int(_offset),
+		MTP_int(offset),
 		MTP_int(perPage),
 		MTP_long(participantsHash)
-	)).done([=](const MTPchannels_ChannelParticipants &result) {
+	)).parseInBackground().done([=](
+			const MTPchannels_ChannelParticipants &received) {
 		const auto firstLoad = !_offset;
 		_loadRequestId = 0;
 
+		auto &api = channel->session().api();
+		const auto result = api.channelParticipantsReceived(
+			channel,
+			filter,
+			offset,
+			perPage,
+			received);
+
 		auto wasRecentRequest = firstLoad
 			&& (_role == Role::Members || _role == Role::Profile);
+		auto notModified = false;
+		const auto markNotModified = [&] {
+			notModified = true;
+		};
 		auto parseParticipants = [&](auto &&result, auto &&callback) {
 			if (wasRecentRequest) {
 				channel->session().api().parseRecentChannelParticipants(
 					channel,
 					result,
-					callback);
+					callback,
+					markNotModified);
 			} else {
 				channel->session().api().parseChannelParticipants(
 					channel,
 					result,
-					callback);
+					callback,
+					markNotModified);
 			}
 		};
 		parseParticipants(result, [&](
@@ -1352,6 +1371,12 @@ void ParticipantsBoxController::loadMoreRows() {
 				_allLoaded = true;
 			}
 		});
+		if (notModified) {
+			// The cached page was dropped while we were waiting for it,
+			// so request it once again, now without the hash.
+			loadMoreRows();
+			return;
+		}
 
 		if (_allLoaded
 			|| (firstLoad && delegate()->peerListFullRowsCount() > 0)) {
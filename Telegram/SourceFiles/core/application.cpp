@@ -22,6 +22,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/sandbox.h"
 #include "core/local_url_handlers.h"
 #include "core/launcher.h"
+#include "core/core_startup_trace.h"
 #include "core/ui_integration.h"
 #include "chat_helpers/emoji_keywords.h"
 #include "chat_helpers/stickers_emoji_image_loader.h"
@@ -211,7 +212,19 @@ Application::~Application() {
 }
 
 void Application::run() {
-	style::internal::StartFonts();
+	const auto span = StartupSpan("Application::run");
+
+	// Create mime database, so it won't be slow later.
+	// QMimeDatabase is thread-safe, so warm it up in parallel.
+	crl::async([] {
+		const auto span = StartupSpan("QMimeDatabase");
+		QMimeDatabase().mimeTypeForName(qsl("text/plain"));
+	});
+
+	{
+		const auto span = StartupSpan("style::internal::StartFonts");
+		style::internal::StartFonts();
+	}
 
 	ThirdParty::start();
 	refreshGlobalProxy(); // Depends on Core::IsAppLaunched().
@@ -220,7 +233,10 @@ void Application::run() {
 	// Depends on notifications settings.
 	_notifications = std::make_unique<Window::Notifications::System>();
 
-	startLocalStorage();
+	{
+		const auto span = StartupSpan("startLocalStorage");
+		startLocalStorage();
+	}
 	ValidateScale();
 
 	if (Local::oldSettingsVersion() < AppVersion) {
@@ -241,13 +257,22 @@ void Application::run() {
 	_translator = std::make_unique<Lang::Translator>();
 	QCoreApplication::instance()->installTranslator(_translator.get());
 
-	style::startManager(cScale());
+	{
+		const auto span = StartupSpan("style::startManager");
+		style::startManager(cScale());
+	}
 	Ui::InitTextOptions();
 	Ui::StartCachedCorners();
-	Ui::Emoji::Init();
+	{
+		const auto span = StartupSpan("Ui::Emoji::Init");
+		Ui::Emoji::Init();
+	}
 	startEmojiImageLoader();
 	startSystemDarkModeViewer();
-	Media::Player::start(_audio.get());
+	{
+		const auto span = StartupSpan("Media::Player::start");
+		Media::Player::start(_audio.get());
+	}
 
 	style::ShortAnimationPlaying(
 	) | rpl::start_with_next([=](bool playing) {
@@ -264,10 +289,10 @@ void Application::run() {
 
 	DEBUG_LOG(("Application Info: starting app..."));
 
-	// Create mime database, so it won't be slow later.
-	QMimeDatabase().mimeTypeForName(qsl("text/plain"));
-
-	_window = std::make_unique<Window::Controller>();
+	{
+		const auto span = StartupSpan("Window::Controller");
+		_window = std::make_unique<Window::Controller>();
+	}
 
 	_domain->activeChanges(
 	) | rpl::start_with_next([=](not_null<Main::Account*> account) {
@@ -289,7 +314,10 @@ void Application::run() {
 
 	// Depend on activeWindow() for now :(
 	startShortcuts();
-	startDomain();
+	{
+		const auto span = StartupSpan("startDomain");
+		startDomain();
+	}
 
 	_window->widget()->show();
 
@@ -298,7 +326,10 @@ void Application::run() {
 	_window->widget()->Ui::RpWidget::setGeometry(currentGeometry);
 
 	DEBUG_LOG(("Application Info: showing."));
-	_window->finishFirstShow();
+	{
+		const auto span = StartupSpan("finishFirstShow");
+		_window->finishFirstShow();
+	}
 
 	if (!_window->locked() && cStartToSettings()) {
 		_window->showSettings();
@@ -329,6 +360,11 @@ void Application::run() {
 			[[maybe_unused]] const auto countriesCopy = countries;
 		});
 	}
+
+	// Let the first frame be painted and the async stages finish.
+	crl::on_main([] {
+		WriteStartupTrace();
+	});
 }
 
 void Application::showOpenGLCrashNotification() {
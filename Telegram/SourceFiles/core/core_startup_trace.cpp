@@ -0,0 +1,104 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/core_startup_trace.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+
+namespace Core {
+namespace {
+
+struct Span {
+	const char *name = nullptr;
+	quintptr threadId = 0;
+	int64 started = 0;
+	int64 duration = 0;
+};
+
+struct Trace {
+	Trace() {
+		timer.start();
+	}
+
+	QElapsedTimer timer;
+	QMutex mutex;
+	std::vector<Span> spans;
+	bool written = false;
+};
+
+[[nodiscard]] Trace &GlobalTrace() {
+	static Trace result;
+	return result;
+}
+
+[[nodiscard]] int64 NowMicroseconds() {
+	return GlobalTrace().timer.nsecsElapsed() / 1000;
+}
+
+} // namespace
+
+StartupSpan::StartupSpan(const char *name)
+: _name(Logs::DebugEnabled() ? name : nullptr)
+, _started(_name ? NowMicroseconds() : 0) {
+}
+
+StartupSpan::~StartupSpan() {
+	if (!_name) {
+		return;
+	}
+	const auto finished = NowMicroseconds();
+	auto &trace = GlobalTrace();
+	QMutexLocker lock(&trace.mutex);
+	if (!trace.written) {
+		trace.spans.push_back({
+			.name = _name,
+			.threadId = quintptr(QThread::currentThreadId()),
+			.started = _started,
+			.duration = finished - _started,
+		});
+	}
+}
+
+void WriteStartupTrace() {
+	if (!Logs::DebugEnabled()) {
+		return;
+	}
+	auto &trace = GlobalTrace();
+	auto spans = std::vector<Span>();
+	{
+		QMutexLocker lock(&trace.mutex);
+		if (trace.written) {
+			return;
+		}
+		trace.written = true;
+		spans = base::take(trace.spans);
+	}
+	auto result = QByteArray("[\n");
+	for (const auto &span : spans) {
+		if (result.size() > 2) {
+			result.append(",\n");
+		}
+		result.append(QString(
+			"{\"name\":\"%1\",\"ph\":\"X\",\"pid\":1,"
+			"\"tid\":%2,\"ts\":%3,\"dur\":%4}"
+		).arg(span.name
+		).arg(span.threadId
+		).arg(span.started
+		).arg(span.duration).toUtf8());
+	}
+	result.append("\n]\n");
+
+	QFile f(cWorkingDir() + u"DebugLogs/startup_trace.json"_q);
+	if (f.open(QIODevice::WriteOnly)) {
+		f.write(result);
+	}
+}
+
+} // namespace Core
@@ -0,0 +1,30 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Core {
+
+// Measures a startup stage, only when debug logs are enabled.
+// Spans from any thread are collected and written by WriteStartupTrace.
+class StartupSpan final {
+public:
+	explicit StartupSpan(const char *name);
+	StartupSpan(const StartupSpan &other) = delete;
+	StartupSpan &operator=(const StartupSpan &other) = delete;
+	~StartupSpan();
+
+private:
+	const char *_name = nullptr;
+	int64 _started = 0;
+
+};
+
+// Writes DebugLogs/startup_trace.json in chrome://tracing format.
+void WriteStartupTrace();
+
+} // namespace Core
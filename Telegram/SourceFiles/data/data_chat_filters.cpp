@@ -174,8 +174,8 @@ const base::flat_set<not_null<History*>> &ChatFilter::never() const {
 	return _never;
 }
 
-bool ChatFilter::contains(not_null<History*> history) const {
-	const auto flag = [&] {
+ChatFilter::Flags ChatFilter::HistoryFlags(not_null<History*> history) {
+	const auto type = [&] {
 		const auto peer = history->peer;
 		if (const auto user = peer->asUser()) {
 			return user->isBot()
@@ -192,26 +192,43 @@ bool ChatFilter::contains(not_null<History*> history) const {
 				return Flag::Groups;
 			}
 		} else {
-			Unexpected("Peer type in ChatFilter::contains.");
+			Unexpected("Peer type in ChatFilter::HistoryFlags.");
 		}
 	}();
+	const auto inMain = history->folderKnown() && !history->folder();
+	const auto muted = history->mute()
+		&& !(history->hasUnreadMentions() && inMain);
+	const auto read = !history->unreadCount()
+		&& !history->unreadMark()
+		&& !history->hasUnreadMentions()
+		&& !history->fakeUnreadWhileOpened();
+	return Flags(type)
+		| (muted ? Flag::NoMuted : Flag(0))
+		| (read ? Flag::NoRead : Flag(0))
+		| (inMain ? Flag(0) : Flag::NoArchived);
+}
+
+bool ChatFilter::contains(not_null<History*> history) const {
+	return contains(history, HistoryFlags(history));
+}
+
+bool ChatFilter::contains(
+		not_null<History*> history,
+		Flags historyFlags) const {
+	constexpr auto kTypes = Flag::Contacts
+		| Flag::NonContacts
+		| Flag::Groups
+		| Flag::Channels
+		| Flag::Bots;
+	constexpr auto kExclusions = Flag::NoMuted
+		| Flag::NoRead
+		| Flag::NoArchived;
+
 	if (_never.contains(history)) {
 		return false;
 	}
-	return false
-		|| ((_flags & flag)
-			&& (!(_flags & Flag::NoMuted)
-				|| !history->mute()
-				|| (history->hasUnreadMentions()
-					&& history->folderKnown()
-					&& !history->folder()))
-			&& (!(_flags & Flag::NoRead)
-				|| history->unreadCount()
-				|| history->unreadMark()
-				|| history->hasUnreadMentions()
-				|| history->fakeUnreadWhileOpened())
-			&& (!(_flags & Flag::NoArchived)
-				|| (history->folderKnown() && !history->folder())))
+	const auto matches = _flags & historyFlags;
+	return ((matches & kTypes) && !(matches & kExclusions))
 		|| _always.contains(history);
 }
 
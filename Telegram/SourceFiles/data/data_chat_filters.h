@@ -60,7 +60,14 @@ public:
 	[[nodiscard]] const std::vector<not_null<History*>> &pinned() const;
 	[[nodiscard]] const base::flat_set<not_null<History*>> &never() const;
 
+	// Type flag of the history and the exclusion flags it falls under.
+	// Computed once and checked against any number of filters.
+	[[nodiscard]] static Flags HistoryFlags(not_null<History*> history);
+
 	[[nodiscard]] bool contains(not_null<History*> history) const;
+	[[nodiscard]] bool contains(
+		not_null<History*> history,
+		Flags historyFlags) const;
 
 private:
 	FilterId _id = 0;
@@ -664,6 +664,10 @@ Storage::Cache::Key DocumentData::bigFileBaseCacheKey() const {
 		: Storage::Cache::Key();
 }
 
+Storage::Cache::Key DocumentData::waveformCacheKey() const {
+	return Data::DocumentWaveformCacheKey(_dc, id);
+}
+
 bool DocumentData::saveToCache() const {
 	return (size < Storage::kMaxFileInMemory)
 		&& ((type == StickerDocument)
@@ -202,6 +202,7 @@ public:
 	[[nodiscard]] PhotoData *goodThumbnailPhoto() const;
 
 	[[nodiscard]] Storage::Cache::Key bigFileBaseCacheKey() const;
+	[[nodiscard]] Storage::Cache::Key waveformCacheKey() const;
 
 	void setRemoteLocation(
 		int32 dc,
@@ -308,7 +308,8 @@ void Folder::applyDialog(const MTPDdialogFolder &data) {
 		_chatsList.clear();
 		updateChatListExistence();
 	}
-	if (_chatsList.indexed()->size() < kLoadedChatsMinCount) {
+	if (!_chatsList.loaded()
+		&& _chatsList.indexed()->size() < kLoadedChatsMinCount) {
 		session().api().requestDialogs(this);
 	}
 }
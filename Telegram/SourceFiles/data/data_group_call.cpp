@@ -224,8 +224,21 @@ const GroupCallParticipant *GroupCall::participantByPeer(
 
 GroupCallParticipant *GroupCall::findParticipant(
 		not_null<PeerData*> peer) {
-	const auto i = ranges::find(_participants, peer, &Participant::peer);
-	return (i != end(_participants)) ? &*i : nullptr;
+	const auto i = _participantIndexByPeer.find(peer);
+	return (i != end(_participantIndexByPeer))
+		? &_participants[i->second]
+		: nullptr;
+}
+
+void GroupCall::eraseParticipant(std::vector<Participant>::iterator i) {
+	const auto index = int(i - begin(_participants));
+	_participantIndexByPeer.erase(i->peer);
+	for (auto &[peer, participantIndex] : _participantIndexByPeer) {
+		if (participantIndex > index) {
+			--participantIndex;
+		}
+	}
+	_participants.erase(i);
 }
 
 const GroupCallParticipant *GroupCall::participantByEndpoint(
@@ -350,6 +363,8 @@ void GroupCall::processFullCallFields(const MTPphone_GroupCall &call) {
 		const auto nextOffset = qs(data.vparticipants_next_offset());
 		data.vcall().match([&](const MTPDgroupCall &data) {
 			_participants.clear();
+			_participantIndexByPeer.clear();
+			_participantIndexByPeer.reserve(participants.size());
 			_speakingByActiveFinishes.clear();
 			_participantPeerByAudioSsrc.clear();
 			_allParticipantsLoaded = false;
@@ -537,10 +552,10 @@ void GroupCall::applyParticipantsSlice(
 			const auto participantPeerId = peerFromMTP(data.vpeer());
 			const auto participantPeer = _peer->owner().peer(
 				participantPeerId);
-			const auto i = ranges::find(
-				_participants,
-				participantPeer,
-				&Participant::peer);
+			const auto index = _participantIndexByPeer.find(participantPeer);
+			const auto i = (index != end(_participantIndexByPeer))
+				? (begin(_participants) + index->second)
+				: end(_participants);
 			if (data.is_left()) {
 				if (i != end(_participants)) {
 					auto update = ParticipantUpdate{
@@ -550,7 +565,7 @@ void GroupCall::applyParticipantsSlice(
 					_participantPeerByAudioSsrc.erase(
 						GetAdditionalAudioSsrc(i->videoParams));
 					_speakingByActiveFinishes.remove(participantPeer);
-					_participants.erase(i);
+					eraseParticipant(i);
 					if (sliceSource != ApplySliceSource::FullReloaded) {
 						_participantUpdates.fire(std::move(update));
 					}
@@ -632,6 +647,9 @@ void GroupCall::applyParticipantsSlice(
 						additional,
 						participantPeer);
 				}
+				_participantIndexByPeer.emplace(
+					participantPeer,
+					int(_participants.size()));
 				_participants.push_back(value);
 				if (const auto user = participantPeer->asUser()) {
 					_peer->owner().unregisterInvitedToCallUser(_id, user);
@@ -884,11 +902,7 @@ void GroupCall::requestUnknownParticipants() {
 		}
 		for (const auto &[id, when] : participantPeerIds) {
 			if (const auto participantPeer = _peer->owner().peerLoaded(id)) {
-				const auto isParticipant = ranges::contains(
-					_participants,
-					not_null{ participantPeer },
-					&Participant::peer);
-				if (isParticipant) {
+				if (findParticipant(participantPeer)) {
 					applyActiveUpdate(id, when, participantPeer);
 				}
 			}
@@ -25,6 +25,9 @@ namespace {
 
 constexpr auto kReadRequestTimeout = 3 * crl::time(1000);
 
+// Read requests may wait a bit to go in one container with others.
+constexpr auto kReadRequestCanWait = crl::time(100);
+
 } // namespace
 
 Histories::Histories(not_null<Session*> owner)
@@ -513,7 +516,7 @@ void Histories::sendReadRequest(not_null<History*> history, State &state) {
 				finished();
 			}).fail([=](const MTP::Error &error) {
 				finished();
-			}).send();
+			}).afterDelay(kReadRequestCanWait).send();
 		} else {
 			return session().api().request(MTPmessages_ReadHistory(
 				history->peer->input,
@@ -523,7 +526,7 @@ void Histories::sendReadRequest(not_null<History*> history, State &state) {
 				finished();
 			}).fail([=](const MTP::Error &error) {
 				finished();
-			}).send();
+			}).afterDelay(kReadRequestCanWait).send();
 		}
 	});
 }
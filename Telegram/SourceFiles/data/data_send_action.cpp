@@ -11,7 +11,14 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history.h"
 #include "history/view/history_view_send_action.h"
 
+#include <QtCore/QElapsedTimer>
+
 namespace Data {
+namespace {
+
+constexpr auto kStatsPeriod = crl::time(1000);
+
+} // namespace
 
 SendActionManager::SendActionManager()
 : _animation([=](crl::time now) { return callback(now); }) {
@@ -115,6 +122,10 @@ void SendActionManager::repliesPaintersClear(
 }
 
 bool SendActionManager::callback(crl::time now) {
+	auto timer = QElapsedTimer();
+	if (Logs::DebugEnabled()) {
+		timer.start();
+	}
 	for (auto i = begin(_sendActions); i != end(_sendActions);) {
 		const auto sendAction = lookupPainter(
 			i->first.first,
@@ -125,9 +136,30 @@ bool SendActionManager::callback(crl::time now) {
 			i = _sendActions.erase(i);
 		}
 	}
+	if (timer.isValid()) {
+		accumulateStats(now, timer.nsecsElapsed());
+	}
 	return !_sendActions.empty();
 }
 
+void SendActionManager::accumulateStats(crl::time now, qint64 spent) {
+	if (!_statsStart) {
+		_statsStart = now;
+	}
+	_statsSpent += spent;
+	++_statsFrames;
+	if (now - _statsStart >= kStatsPeriod) {
+		DEBUG_LOG(("Send Action Info: "
+			"%1 frames, %2 us spent in %3 ms."
+			).arg(_statsFrames
+			).arg(_statsSpent / 1000
+			).arg(now - _statsStart));
+		_statsStart = now;
+		_statsSpent = 0;
+		_statsFrames = 0;
+	}
+}
+
 auto SendActionManager::animationUpdated() const
 -> rpl::producer<SendActionManager::AnimationUpdate> {
 	return _animationUpdate.events();
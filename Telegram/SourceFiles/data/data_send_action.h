@@ -57,6 +57,7 @@ public:
 
 private:
 	bool callback(crl::time now);
+	void accumulateStats(crl::time now, qint64 spent);
 	[[nodiscard]] SendActionPainter *lookupPainter(
 		not_null<History*> history,
 		MsgId rootId);
@@ -66,6 +67,9 @@ private:
 		std::pair<not_null<History*>, MsgId>,
 		crl::time> _sendActions;
 	Ui::Animations::Basic _animation;
+	crl::time _statsStart = 0;
+	qint64 _statsSpent = 0;
+	int _statsFrames = 0;
 
 	rpl::event_stream<AnimationUpdate> _animationUpdate;
 	rpl::event_stream<not_null<History*>> _speakingAnimationUpdate;
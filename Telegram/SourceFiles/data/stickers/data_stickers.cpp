@@ -977,13 +977,12 @@ std::vector<not_null<DocumentData*>> Stickers::getListByEmoji(
 		TimeId date = 0;
 	};
 	auto result = std::vector<StickerWithDate>();
+	auto added = std::unordered_set<not_null<DocumentData*>>();
 	auto &sets = setsRef();
 	auto setsToRequest = base::flat_map<uint64, uint64>();
 
 	const auto add = [&](not_null<DocumentData*> document, TimeId date) {
-		if (ranges::find(result, document, [](const StickerWithDate &data) {
-			return data.document;
-		}) == result.end()) {
+		if (added.emplace(document).second) {
 			result.push_back({ document, date });
 		}
 	};
@@ -1055,9 +1054,7 @@ std::vector<not_null<DocumentData*>> Stickers::getListByEmoji(
 				const auto date = usageDate
 					? usageDate
 					: InstallDate(document);
-				result.push_back({
-					document,
-					date ? date : CreateRecentSortKey(document) });
+				add(document, date ? date : CreateRecentSortKey(document));
 			}
 		}
 	}
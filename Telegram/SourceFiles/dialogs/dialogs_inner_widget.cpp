@@ -230,9 +230,12 @@ InnerWidget::InnerWidget(
 		| UpdateFlag::Photo
 		| UpdateFlag::IsContact
 	) | rpl::start_with_next([=](const Data::PeerUpdate &update) {
-		if (update.flags & (UpdateFlag::Name | UpdateFlag::Photo)) {
+		if (update.flags & UpdateFlag::Name) {
 			this->update();
 			_updated.fire({});
+		} else if (update.flags & UpdateFlag::Photo) {
+			repaintPeerUserpic(update.peer);
+			_updated.fire({});
 		}
 		if (update.flags & UpdateFlag::IsContact) {
 			// contactsNoChatsList could've changed.
@@ -1528,6 +1531,17 @@ void InnerWidget::repaintDialogRow(
 	}
 }
 
+void InnerWidget::repaintPeerUserpic(not_null<PeerData*> peer) {
+	if (_state != WidgetState::Default) {
+		update();
+		return;
+	}
+	// In the chats list a userpic is shown only in the row of its peer.
+	if (const auto history = session().data().historyLoaded(peer)) {
+		updateDialogRow(RowDescriptor(history, FullMsgId()));
+	}
+}
+
 void InnerWidget::repaintDialogRow(RowDescriptor row) {
 	updateDialogRow(row);
 }
@@ -254,6 +254,7 @@ private:
 	friend inline constexpr auto is_flag_type(UpdateRowSection) { return true; };
 
 	void updateSearchResult(not_null<PeerData*> peer);
+	void repaintPeerUserpic(not_null<PeerData*> peer);
 	void updateDialogRow(
 		RowDescriptor row,
 		QRect updateRect = QRect(),
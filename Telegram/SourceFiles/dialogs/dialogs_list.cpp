@@ -62,19 +62,24 @@ not_null<Row*> List::addByName(Key key) {
 void List::adjustByName(not_null<Row*> row) {
 	Expects(row->pos() >= 0 && row->pos() < _rows.size());
 
+	// All the other rows are sorted, so we can use binary search.
 	const auto &key = row->entry()->chatListNameSortKey();
+	const auto compare = [&](not_null<Row*> other) {
+		return other->entry()->chatListNameSortKey().compare(key);
+	};
 	const auto index = row->pos();
 	const auto i = _rows.begin() + index;
-	const auto before = std::find_if(i + 1, _rows.end(), [&](Row *row) {
-		return row->entry()->chatListNameSortKey().compare(key) >= 0;
-	});
+	const auto before = std::partition_point(
+		i + 1,
+		_rows.end(),
+		[&](not_null<Row*> other) { return compare(other) < 0; });
 	if (before != i + 1) {
 		rotate(i, i + 1, before);
 	} else if (i != _rows.begin()) {
-		const auto from = std::make_reverse_iterator(i);
-		const auto after = std::find_if(from, _rows.rend(), [&](Row *row) {
-			return row->entry()->chatListNameSortKey().compare(key) <= 0;
-		}).base();
+		const auto after = std::partition_point(
+			_rows.begin(),
+			i,
+			[&](not_null<Row*> other) { return compare(other) <= 0; });
 		if (after != i) {
 			rotate(after, i, i + 1);
 		}
@@ -85,18 +90,32 @@ void List::adjustByDate(not_null<Row*> row) {
 	Expects(_sortMode == SortMode::Date);
 
 	const auto key = row->sortKey(_filterId);
+	const auto higher = [&](not_null<Row*> other) {
+		return (other->sortKey(_filterId) > key);
+	};
+	const auto notLower = [&](not_null<Row*> other) {
+		return (other->sortKey(_filterId) >= key);
+	};
+
+	// Pinned indices are applied one by one when pinned chats are
+	// reordered, so the other pinned rows may be unsorted at this point.
+	// Not pinned rows are always sorted and placed below all pinned rows,
+	// so for them we can use binary search.
+	const auto sorted = !row->entry()->isPinnedDialog(_filterId);
 	const auto index = row->pos();
 	const auto i = _rows.begin() + index;
-	const auto before = std::find_if(i + 1, _rows.end(), [&](Row *row) {
-		return (row->sortKey(_filterId) <= key);
-	});
+	const auto before = sorted
+		? std::partition_point(i + 1, _rows.end(), higher)
+		: std::find_if_not(i + 1, _rows.end(), higher);
 	if (before != i + 1) {
 		rotate(i, i + 1, before);
 	} else {
-		const auto from = std::make_reverse_iterator(i);
-		const auto after = std::find_if(from, _rows.rend(), [&](Row *row) {
-			return (row->sortKey(_filterId) >= key);
-		}).base();
+		const auto after = sorted
+			? std::partition_point(_rows.begin(), i, notLower)
+			: std::find_if(
+				std::make_reverse_iterator(i),
+				_rows.rend(),
+				notLower).base();
 		if (after != i) {
 			rotate(after, i, i + 1);
 		}
@@ -31,6 +31,13 @@ constexpr auto kAvioBlockSize = 4096;
 constexpr auto kTimeUnknown = std::numeric_limits<crl::time>::min();
 constexpr auto kDurationMax = crl::time(std::numeric_limits<int>::max());
 
+// Frame area to display area ratios from which we start lowering quality.
+constexpr auto kSkipLoopFilterAreaRatio = 4;
+constexpr auto kSkipNonReferenceAreaRatio = 16;
+
+// Quality is lowered only for previews not larger than that, in pixels.
+constexpr auto kLowQualityMaxDisplaySide = 640;
+
 void AlignedImageBufferCleanupHandler(void* data) {
 	const auto buffer = static_cast<uchar*>(data);
 	delete[] buffer;
@@ -189,6 +196,44 @@ CodecPointer MakeCodecPointer(not_null<AVStream*> stream) {
 	return result;
 }
 
+DecodeQuality ChooseDecodeQuality(QSize frame, QSize display) {
+	if (frame.isEmpty()
+		|| display.isEmpty()
+		|| display.width() > kLowQualityMaxDisplaySide
+		|| display.height() > kLowQualityMaxDisplaySide) {
+		return DecodeQuality::Full;
+	}
+	const auto frameArea = int64_t(frame.width()) * frame.height();
+	const auto displayArea = int64_t(display.width()) * display.height();
+	return (displayArea * kSkipNonReferenceAreaRatio <= frameArea)
+		? DecodeQuality::SkipNonReference
+		: (displayArea * kSkipLoopFilterAreaRatio <= frameArea)
+		? DecodeQuality::SkipLoopFilter
+		: DecodeQuality::Full;
+}
+
+void SetDecodeQuality(
+		not_null<AVCodecContext*> context,
+		DecodeQuality quality) {
+	// Those fields are checked by decoders for each packet,
+	// so they may be changed between avcodec_send_packet calls.
+	switch (quality) {
+	case DecodeQuality::Full:
+		context->skip_loop_filter = AVDISCARD_DEFAULT;
+		context->skip_frame = AVDISCARD_DEFAULT;
+		return;
+	case DecodeQuality::SkipLoopFilter:
+		context->skip_loop_filter = AVDISCARD_NONKEY;
+		context->skip_frame = AVDISCARD_DEFAULT;
+		return;
+	case DecodeQuality::SkipNonReference:
+		context->skip_loop_filter = AVDISCARD_ALL;
+		context->skip_frame = AVDISCARD_NONREF;
+		return;
+	}
+	Unexpected("Quality in FFmpeg::SetDecodeQuality.");
+}
+
 void CodecDeleter::operator()(AVCodecContext *value) {
 	if (value) {
 		avcodec_free_context(&value);
@@ -127,6 +127,16 @@ struct CodecDeleter {
 using CodecPointer = std::unique_ptr<AVCodecContext, CodecDeleter>;
 [[nodiscard]] CodecPointer MakeCodecPointer(not_null<AVStream*> stream);
 
+enum class DecodeQuality : uchar {
+	Full,
+	SkipLoopFilter, // Skip deblocking for non-key frames.
+	SkipNonReference, // Skip deblocking and non-reference frames.
+};
+[[nodiscard]] DecodeQuality ChooseDecodeQuality(QSize frame, QSize display);
+void SetDecodeQuality(
+	not_null<AVCodecContext*> context,
+	DecodeQuality quality);
+
 struct FrameDeleter {
 	void operator()(AVFrame *value);
 };
@@ -381,6 +381,7 @@ void Gif::draw(Painter &p, const PaintContext &context) const {
 		request.resize = QSize(_thumbw, _thumbh) * cIntRetinaFactor();
 		request.corners = roundCorners;
 		request.radius = roundRadius;
+		request.preview = !activeRoundPlaying;
 		if (!activeRoundPlaying && activeOwnPlaying->instance.playerLocked()) {
 			if (activeOwnPlaying->frozenFrame.isNull()) {
 				activeOwnPlaying->frozenRequest = request;
@@ -965,6 +966,7 @@ void Gif::drawGrouped(
 		request.resize = pixSize * cIntRetinaFactor();
 		request.corners = corners;
 		request.radius = roundRadius;
+		request.preview = true;
 		if (activeOwnPlaying->instance.playerLocked()) {
 			if (activeOwnPlaying->frozenFrame.isNull()) {
 				activeOwnPlaying->frozenRequest = request;
@@ -372,6 +372,7 @@ void Photo::paintUserpicFrame(
 		request.outer = size * cIntRetinaFactor();
 		request.resize = size * cIntRetinaFactor();
 		request.radius = ImageRoundRadius::Ellipse;
+		request.preview = true;
 		if (_streamed->instance.playerLocked()) {
 			if (_streamed->frozenFrame.isNull()) {
 				_streamed->frozenFrame = _streamed->instance.frame(request);
@@ -56,6 +56,7 @@ constexpr auto kPreloadIfLessThanScreens = 2;
 constexpr auto kPreloadedScreensCountFull
 	= kPreloadedScreensCount + 1 + kPreloadedScreensCount;
 constexpr auto kMediaCountForSearch = 10;
+constexpr auto kHeavyLayoutsLimit = 160;
 
 UniversalMsgId GetUniversalId(FullMsgId itemId) {
 	return (itemId.channel != 0)
@@ -1342,9 +1343,17 @@ void ListWidget::clearHeavyItems() {
 	if (!visibleHeight) {
 		return;
 	}
+	clearHeavyItemsOutside(
+		_visibleTop - visibleHeight,
+		_visibleBottom + visibleHeight);
+	if (int(_heavyLayouts.size()) > kHeavyLayoutsLimit) {
+		// Too many items around, keep only the visible ones.
+		clearHeavyItemsOutside(_visibleTop, _visibleBottom);
+	}
+}
+
+void ListWidget::clearHeavyItemsOutside(int above, int below) {
 	_heavyLayoutsInvalidated = false;
-	const auto above = _visibleTop - visibleHeight;
-	const auto below = _visibleBottom + visibleHeight;
 	for (auto i = _heavyLayouts.begin(); i != _heavyLayouts.end();) {
 		const auto item = const_cast<BaseLayout*>(i->get());
 		const auto rect = findItemDetails(item).geometry;
@@ -1359,7 +1368,7 @@ void ListWidget::clearHeavyItems() {
 		}
 	}
 	if (_heavyLayoutsInvalidated) {
-		clearHeavyItems();
+		clearHeavyItemsOutside(above, below);
 	}
 }
 
@@ -291,6 +291,7 @@ private:
 	void validateTrippleClickStartTime();
 	void checkMoveToOtherViewer();
 	void clearHeavyItems();
+	void clearHeavyItemsOutside(int above, int below);
 
 	void setActionBoxWeak(QPointer<Ui::RpWidget> box);
 
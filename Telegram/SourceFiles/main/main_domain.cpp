@@ -15,6 +15,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_session.h"
 #include "data/data_changes.h"
 #include "data/data_user.h"
+#include "dialogs/dialogs_main_list.h"
+#include "history/history.h"
 #include "mtproto/mtproto_config.h"
 #include "mtproto/mtproto_dc_options.h"
 #include "storage/storage_domain.h"
@@ -25,10 +27,17 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "facades.h"
 
 namespace Main {
+namespace {
+
+constexpr auto kWarmUpDelay = 10 * crl::time(1000);
+constexpr auto kWarmUpChatsCount = 32;
+
+} // namespace
 
 Domain::Domain(const QString &dataName)
 : _dataName(dataName)
-, _local(std::make_unique<Storage::Domain>(this, dataName)) {
+, _local(std::make_unique<Storage::Domain>(this, dataName))
+, _warmUpTimer([=] { warmUpInactive(); }) {
 	_active.changes(
 	) | rpl::take(1) | rpl::start_with_next([] {
 		// In case we had a legacy passcoded app we start settings here.
@@ -416,6 +425,10 @@ void Domain::activate(not_null<Main::Account*> account) {
 	_active.current()->sessionValue(
 	) | rpl::start_to_stream(_activeSessions, _activeLifetime);
 
+	if (_accounts.size() > 1) {
+		_warmUpTimer.callOnce(kWarmUpDelay);
+	}
+
 	if (changed) {
 		if (wasAuthed) {
 			scheduleWriteAccounts();
@@ -427,6 +440,30 @@ void Domain::activate(not_null<Main::Account*> account) {
 	}
 }
 
+void Domain::warmUpInactive() {
+	// Inactive sessions keep receiving updates and load their dialogs,
+	// but nothing requests the userpics of their chats until the switch.
+	// Load the top ones to the cache, so the chats list is painted at once.
+	for (const auto &[index, account] : _accounts) {
+		if (account.get() == _active.current()) {
+			continue;
+		}
+		const auto session = account->maybeSession();
+		if (!session) {
+			continue;
+		}
+		auto left = kWarmUpChatsCount;
+		for (const auto &row : *session->data().chatsList()->indexed()) {
+			if (const auto history = row->history()) {
+				history->peer->loadUserpic();
+				if (!--left) {
+					break;
+				}
+			}
+		}
+	}
+}
+
 void Domain::scheduleWriteAccounts() {
 	if (_writeAccountsScheduled) {
 		return;
@@ -83,6 +83,7 @@ private:
 	void updateUnreadBadge();
 	void scheduleUpdateUnreadBadge();
 	void suggestExportIfNeeded();
+	void warmUpInactive();
 
 	const QString _dataName;
 	const std::unique_ptr<Storage::Domain> _local;
@@ -101,6 +102,8 @@ private:
 	bool _unreadBadgeMuted = true;
 	bool _unreadBadgeUpdateScheduled = false;
 
+	base::Timer _warmUpTimer;
+
 	rpl::lifetime _activeLifetime;
 	rpl::lifetime _lifetime;
 
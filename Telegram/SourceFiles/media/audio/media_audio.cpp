@@ -26,6 +26,14 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include <numeric>
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#define MEDIA_AUDIO_USE_SSE2
+#include <emmintrin.h>
+#elif defined __ARM_NEON || defined _M_ARM64
+#define MEDIA_AUDIO_USE_NEON
+#include <arm_neon.h>
+#endif
+
 Q_DECLARE_METATYPE(AudioMsgId);
 Q_DECLARE_METATYPE(VoiceWaveform);
 
@@ -491,6 +499,11 @@ void Mixer::Track::ensureStreamCreated(AudioMsgId::Type type) {
 	}
 }
 
+bool Mixer::Track::hasFreeBuffer() const {
+	// Buffers are filled in order, processed ones are unqueued lazily.
+	return !samplesCount[kBuffersCount - 1];
+}
+
 int Mixer::Track::getNotQueuedBufferIndex() {
 	// See if there are no free buffers right now.
 	while (samplesCount[kBuffersCount - 1] != 0) {
@@ -1413,6 +1426,14 @@ int32 Fader::updateOnePlayback(Mixer::Track *track, bool &hasPlaying, bool &hasF
 	const auto waitingForDataOld = track->state.waitingForData;
 	track->state.waitingForData = stoppedAtEnd
 		&& (track->state.state != State::Stopping);
+	if (track->state.waitingForData
+		&& !waitingForDataOld
+		&& !track->loaded) {
+		++track->state.underrunsCount;
+		DEBUG_LOG(("Audio Info: underrun #%1 in track %2."
+			).arg(track->state.underrunsCount
+			).arg(int(track->state.id.type())));
+	}
 	const auto fullPosition = track->bufferedPosition + positionInBuffered;
 
 	auto playing = (track->state.state == State::Playing);
@@ -1715,6 +1736,69 @@ Ui::PreparedFileInformation::Song PrepareForSending(const QString &fname, const
 
 } // namespace Player
 
+namespace {
+
+[[nodiscard]] uint16 CountPeak(const uchar *samples, int64 count) {
+	auto minimum = uchar(0x80);
+	auto maximum = uchar(0x80);
+	for (auto i = int64(); i != count; ++i) {
+		accumulate_min(minimum, samples[i]);
+		accumulate_max(maximum, samples[i]);
+	}
+	return std::max(
+		Audio::ReadOneSample(minimum),
+		Audio::ReadOneSample(maximum));
+}
+
+[[nodiscard]] uint16 CountPeak(const int16 *samples, int64 count) {
+	constexpr auto kLanes = 8;
+
+	auto minimum = int16(0);
+	auto maximum = int16(0);
+	auto i = int64();
+#if defined MEDIA_AUDIO_USE_SSE2 || defined MEDIA_AUDIO_USE_NEON
+	if (count >= kLanes) {
+		int16 minimums[kLanes] = { 0 };
+		int16 maximums[kLanes] = { 0 };
+#ifdef MEDIA_AUDIO_USE_SSE2
+		auto minimumsWide = _mm_setzero_si128();
+		auto maximumsWide = _mm_setzero_si128();
+		for (; i + kLanes <= count; i += kLanes) {
+			const auto values = _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>(samples + i));
+			minimumsWide = _mm_min_epi16(minimumsWide, values);
+			maximumsWide = _mm_max_epi16(maximumsWide, values);
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(minimums), minimumsWide);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(maximums), maximumsWide);
+#else // MEDIA_AUDIO_USE_SSE2
+		auto minimumsWide = vdupq_n_s16(0);
+		auto maximumsWide = vdupq_n_s16(0);
+		for (; i + kLanes <= count; i += kLanes) {
+			const auto values = vld1q_s16(samples + i);
+			minimumsWide = vminq_s16(minimumsWide, values);
+			maximumsWide = vmaxq_s16(maximumsWide, values);
+		}
+		vst1q_s16(minimums, minimumsWide);
+		vst1q_s16(maximums, maximumsWide);
+#endif // MEDIA_AUDIO_USE_SSE2
+		for (auto lane = 0; lane != kLanes; ++lane) {
+			accumulate_min(minimum, minimums[lane]);
+			accumulate_max(maximum, maximums[lane]);
+		}
+	}
+#endif // MEDIA_AUDIO_USE_SSE2 || MEDIA_AUDIO_USE_NEON
+	for (; i != count; ++i) {
+		accumulate_min(minimum, samples[i]);
+		accumulate_max(maximum, samples[i]);
+	}
+	return std::max(
+		Audio::ReadOneSample(minimum),
+		Audio::ReadOneSample(maximum));
+}
+
+} // namespace
+
 class FFMpegWaveformCounter : public FFMpegLoader {
 public:
 	FFMpegWaveformCounter(const Core::FileLocation &file, const QByteArray &data) : FFMpegLoader(file, data, bytes::vector()) {
@@ -1739,13 +1823,22 @@ public:
 
 		auto fmt = format();
 		auto peak = uint16(0);
-		auto callback = [&](uint16 sample) {
-			accumulate_max(peak, sample);
-			sumbytes += Media::Player::kWaveformSamplesCount;
-			if (sumbytes >= countbytes) {
-				sumbytes -= countbytes;
-				peaks.push_back(peak);
-				peak = 0;
+		const auto countPeaks = [&](const auto *samples, int64 count) {
+			while (count > 0) {
+				// Process all the samples till the next peak in one pass.
+				const auto left = countbytes - sumbytes;
+				const auto till = (left + Media::Player::kWaveformSamplesCount - 1)
+					/ Media::Player::kWaveformSamplesCount;
+				const auto take = std::min(till, count);
+				accumulate_max(peak, CountPeak(samples, take));
+				samples += take;
+				count -= take;
+				sumbytes += take * Media::Player::kWaveformSamplesCount;
+				if (sumbytes >= countbytes) {
+					sumbytes -= countbytes;
+					peaks.push_back(peak);
+					peak = 0;
+				}
 			}
 		};
 		while (processed < countbytes) {
@@ -1760,11 +1853,14 @@ public:
 				continue;
 			}
 
-			auto sampleBytes = bytes::make_span(buffer);
 			if (fmt == AL_FORMAT_MONO8 || fmt == AL_FORMAT_STEREO8) {
-				Media::Audio::IterateSamples<uchar>(sampleBytes, callback);
+				countPeaks(
+					reinterpret_cast<const uchar*>(buffer.constData()),
+					buffer.size());
 			} else if (fmt == AL_FORMAT_MONO16 || fmt == AL_FORMAT_STEREO16) {
-				Media::Audio::IterateSamples<int16>(sampleBytes, callback);
+				countPeaks(
+					reinterpret_cast<const int16*>(buffer.constData()),
+					buffer.size() / int64(sizeof(int16)));
 			}
 			processed += sampleSize() * samples;
 		}
@@ -126,6 +126,7 @@ struct TrackState {
 	int64 length = 0;
 	int frequency = kDefaultFrequency;
 	int fileHeaderSize = 0;
+	int underrunsCount = 0; // Stops because the loader didn't keep up.
 	bool waitingForData = false;
 };
 
@@ -223,6 +224,7 @@ private:
 		void ensureStreamCreated(AudioMsgId::Type type);
 
 		int getNotQueuedBufferIndex();
+		[[nodiscard]] bool hasFreeBuffer() const;
 
 		// Thread: Main. Must be locked: AudioMutex.
 		void setExternalData(std::unique_ptr<ExternalSoundData> data);
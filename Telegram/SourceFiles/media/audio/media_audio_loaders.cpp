@@ -151,6 +151,13 @@ void Loaders::onLoad(const AudioMsgId &audio) {
 }
 
 void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
+	// Fill all the free buffers at once, so that a short stall of
+	// this thread right after starting doesn't starve the source.
+	while (loadDataPart(audio, positionMs)) {
+	}
+}
+
+bool Loaders::loadDataPart(AudioMsgId audio, crl::time positionMs) {
 	auto err = SetupNoErrorStarted;
 	auto type = audio.type();
 	auto l = setupLoader(audio, err, positionMs);
@@ -158,7 +165,7 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 		if (err == SetupErrorAtStart) {
 			emitError(type);
 		}
-		return;
+		return false;
 	}
 
 	auto started = (err == SetupNoErrorStarted);
@@ -183,7 +190,7 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 					}
 				}
 				emitError(type);
-				return;
+				return false;
 			}
 			finished = true;
 			break;
@@ -204,7 +211,7 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 		QMutexLocker lock(internal::audioPlayerMutex());
 		if (!checkLoader(type)) {
 			clear(type);
-			return;
+			return false;
 		}
 	}
 
@@ -212,7 +219,7 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 	auto track = checkLoader(type);
 	if (!track) {
 		clear(type);
-		return;
+		return false;
 	}
 
 	if (started || samplesCount) {
@@ -223,7 +230,7 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 		if (!internal::audioCheckError()) {
 			setStoppedState(track, State::StoppedAtStart);
 			emitError(type);
-			return;
+			return false;
 		}
 
 		track->format = l->format();
@@ -242,12 +249,12 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 		if (!internal::audioCheckError()) {
 			setStoppedState(track, State::StoppedAtError);
 			emitError(type);
-			return;
+			return false;
 		}
 
 		if (bufferIndex < 0) { // No free buffers, wait.
 			l->saveDecodedSamples(&samples, &samplesCount);
-			return;
+			return false;
 		} else if (l->forceToBuffer()) {
 			l->setForceToBuffer(false);
 		}
@@ -262,11 +269,11 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 		if (!internal::audioCheckError()) {
 			setStoppedState(track, State::StoppedAtError);
 			emitError(type);
-			return;
+			return false;
 		}
 	} else {
 		if (waiting) {
-			return;
+			return false;
 		}
 		finished = true;
 	}
@@ -278,30 +285,31 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 		clear(type);
 	}
 
-	track->loading = false;
+	const auto more = !finished && track->hasFreeBuffer();
+	track->loading = more;
 	if (IsPausedOrPausing(track->state.state)
 		|| IsStoppedOrStopping(track->state.state)) {
-		return;
+		return more;
 	}
 	ALint state = AL_INITIAL;
 	alGetSourcei(track->stream.source, AL_SOURCE_STATE, &state);
 	if (!internal::audioCheckError()) {
 		setStoppedState(track, State::StoppedAtError);
 		emitError(type);
-		return;
+		return false;
 	}
 
 	if (state == AL_PLAYING) {
-		return;
+		return more;
 	} else if (state == AL_STOPPED && !internal::CheckAudioDeviceConnected()) {
-		return;
+		return more;
 	}
 
 	alSourcef(track->stream.source, AL_GAIN, ComputeVolume(type));
 	if (!internal::audioCheckError()) {
 		setStoppedState(track, State::StoppedAtError);
 		emitError(type);
-		return;
+		return false;
 	}
 
 	if (state == AL_STOPPED) {
@@ -309,17 +317,18 @@ void Loaders::loadData(AudioMsgId audio, crl::time positionMs) {
 		if (!internal::audioCheckError()) {
 			setStoppedState(track, State::StoppedAtError);
 			emitError(type);
-			return;
+			return false;
 		}
 	}
 	alSourcePlay(track->stream.source);
 	if (!internal::audioCheckError()) {
 		setStoppedState(track, State::StoppedAtError);
 		emitError(type);
-		return;
+		return false;
 	}
 
 	needToCheck();
+	return more;
 }
 
 AudioPlayerLoader *Loaders::setupLoader(
@@ -62,6 +62,7 @@ private:
 		SetupNoErrorStarted = 3,
 	};
 	void loadData(AudioMsgId audio, crl::time positionMs = 0);
+	[[nodiscard]] bool loadDataPart(AudioMsgId audio, crl::time positionMs);
 	AudioPlayerLoader *setupLoader(
 		const AudioMsgId &audio,
 		SetupError &err,
@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "media/player/media_player_instance.h"
 
 #include "data/data_document.h"
+#include "data/data_document_media.h"
 #include "data/data_session.h"
 #include "data/data_streaming.h"
 #include "data/data_file_click_handler.h"
@@ -22,6 +23,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_media_types.h"
 #include "data/data_file_origin.h"
 #include "window/window_session_controller.h"
+#include "storage/file_download.h" // kMaxFileInMemory.
 #include "core/shortcuts.h"
 #include "core/application.h"
 #include "main/main_domain.h" // Domain::activeSessionValue.
@@ -42,6 +44,10 @@ constexpr auto kIdsLimit = 32;
 // Preload next messages if we went further from current than that.
 constexpr auto kIdsPreloadAfter = 28;
 
+// Load next tracks in the playlist ahead so that they start without delay.
+constexpr auto kPreloadNextCount = 3;
+constexpr auto kPreloadNextSizeLimit = int64(Storage::kMaxFileInMemory);
+
 constexpr auto kMinLengthForSavePosition = 20 * TimeId(60); // 20 minutes.
 
 auto VoicePlaybackSpeed() {
@@ -260,9 +266,38 @@ void Instance::playlistUpdated(not_null<Data*> data) {
 	} else {
 		data->playlistIndex = std::nullopt;
 	}
+	preloadNext(data);
 	data->playlistChanges.fire({});
 }
 
+void Instance::preloadNext(not_null<Data*> data) {
+	auto preloaded = std::vector<std::shared_ptr<::Data::DocumentMedia>>();
+	auto size = int64();
+	for (auto i = 0; i != kPreloadNextCount; ++i) {
+		const auto item = data->playlistIndex
+			? itemByIndex(data, *data->playlistIndex + i + 1)
+			: nullptr;
+		const auto media = item ? item->media() : nullptr;
+		const auto document = media ? media->document() : nullptr;
+		if (!document
+			|| !(document->isAudioFile()
+				|| document->isVoiceMessage()
+				|| document->isVideoMessage())) {
+			break;
+		}
+		size += document->size;
+		if (size > kPreloadNextSizeLimit) {
+			break;
+		}
+		auto view = document->createMediaView();
+		if (!document->loading()) {
+			view->automaticLoad(item->fullId(), item);
+		}
+		preloaded.push_back(std::move(view));
+	}
+	data->preloaded = std::move(preloaded);
+}
+
 bool Instance::validPlaylist(not_null<Data*> data) {
 	if (const auto key = playlistKey(data)) {
 		if (!data->playlistSlice) {
@@ -13,6 +13,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 class AudioMsgId;
 class DocumentData;
 
+namespace Data {
+class DocumentMedia;
+} // namespace Data
+
 namespace Media {
 namespace Audio {
 class Instance;
@@ -196,6 +200,7 @@ private:
 		bool isPlaying = false;
 		bool resumeOnCallEnd = false;
 		std::unique_ptr<Streamed> streamed;
+		std::vector<std::shared_ptr<::Data::DocumentMedia>> preloaded;
 	};
 
 	struct SeekingChanges {
@@ -229,6 +234,7 @@ private:
 	bool validPlaylist(not_null<Data*> data);
 	void validatePlaylist(not_null<Data*> data);
 	void playlistUpdated(not_null<Data*> data);
+	void preloadNext(not_null<Data*> data);
 	bool moveInPlaylist(not_null<Data*> data, int delta, bool autonext);
 	HistoryItem *itemByIndex(not_null<Data*> data, int index);
 	void stopAndClear(not_null<Data*> data);
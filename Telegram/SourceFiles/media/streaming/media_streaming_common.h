@@ -122,6 +122,7 @@ struct FrameRequest {
 	RectParts corners = RectPart::AllCorners;
 	bool requireARGB32 = true;
 	bool strict = true;
+	bool preview = false; // Decoding quality may be lowered.
 
 	static FrameRequest NonStrict() {
 		auto result = FrameRequest();
@@ -138,7 +139,8 @@ struct FrameRequest {
 			&& (outer == other.outer)
 			&& (radius == other.radius)
 			&& (corners == other.corners)
-			&& (requireARGB32 == other.requireARGB32);
+			&& (requireARGB32 == other.requireARGB32)
+			&& (preview == other.preview);
 	}
 	[[nodiscard]] bool operator!=(const FrameRequest &other) const {
 		return !(*this == other);
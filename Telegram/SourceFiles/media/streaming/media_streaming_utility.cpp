@@ -11,11 +11,106 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/image/image_prepare.h"
 #include "ffmpeg/ffmpeg_utility.h"
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#define MEDIA_STREAMING_USE_SSE2
+#include <emmintrin.h>
+#elif defined __ARM_NEON || defined _M_ARM64
+#define MEDIA_STREAMING_USE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Media {
 namespace Streaming {
 namespace {
 
 constexpr auto kSkipInvalidDataPackets = 10;
+constexpr auto kOpaqueAlpha = 0xFF000000U;
+
+void FillAlphaLine(uint32 *to, const uint32 *from, int intsCount) {
+	auto i = 0;
+#if defined MEDIA_STREAMING_USE_SSE2
+	const auto mask = _mm_set1_epi32(int(kOpaqueAlpha));
+	for (; i + 4 <= intsCount; i += 4) {
+		const auto pixels = _mm_loadu_si128(
+			reinterpret_cast<const __m128i*>(from + i));
+		_mm_storeu_si128(
+			reinterpret_cast<__m128i*>(to + i),
+			_mm_or_si128(pixels, mask));
+	}
+#elif defined MEDIA_STREAMING_USE_NEON
+	const auto mask = vdupq_n_u32(kOpaqueAlpha);
+	for (; i + 4 <= intsCount; i += 4) {
+		const auto pixels = vld1q_u32(
+			reinterpret_cast<const uint32_t*>(from + i));
+		vst1q_u32(
+			reinterpret_cast<uint32_t*>(to + i),
+			vorrq_u32(pixels, mask));
+	}
+#endif
+	for (; i != intsCount; ++i) {
+		to[i] = kOpaqueAlpha | from[i];
+	}
+}
+
+void FillAlpha(QImage &storage, not_null<const AVFrame*> frame) {
+	static_assert(sizeof(uint32) == FFmpeg::kPixelBytesSize);
+
+	const auto width = frame->width;
+	const auto height = frame->height;
+	const auto toPerLine = storage.bytesPerLine();
+	const auto fromPerLine = frame->linesize[0];
+	auto toBytes = storage.bits();
+	auto fromBytes = static_cast<const uchar*>(frame->data[0]);
+	if (toPerLine != width * 4 || fromPerLine != width * 4) {
+		for (auto y = 0; y != height; ++y) {
+			FillAlphaLine(
+				reinterpret_cast<uint32*>(toBytes),
+				reinterpret_cast<const uint32*>(fromBytes),
+				width);
+			toBytes += toPerLine;
+			fromBytes += fromPerLine;
+		}
+	} else {
+		FillAlphaLine(
+			reinterpret_cast<uint32*>(toBytes),
+			reinterpret_cast<const uint32*>(fromBytes),
+			width * height);
+	}
+}
+
+[[nodiscard]] bool CopyGoodForRequest(
+		const QImage &original,
+		bool alpha,
+		int rotation,
+		const FrameRequest &request) {
+	const auto size = request.resize.isEmpty()
+		? original.size()
+		: request.resize;
+	return !alpha
+		&& !rotation
+		&& (size == original.size())
+		&& (request.outer == size);
+}
+
+void CopyFrameImage(QImage &storage, const QImage &original) {
+	Expects(storage.size() == original.size());
+
+	const auto fromPerLine = original.bytesPerLine();
+	const auto toPerLine = storage.bytesPerLine();
+	const auto lineBytes = original.width() * FFmpeg::kPixelBytesSize;
+	const auto height = original.height();
+	auto from = original.constBits();
+	auto to = storage.bits();
+	if (fromPerLine == toPerLine) {
+		memcpy(to, from, size_t(fromPerLine) * height);
+		return;
+	}
+	for (auto y = 0; y != height; ++y) {
+		memcpy(to, from, lineBytes);
+		from += fromPerLine;
+		to += toPerLine;
+	}
+}
 
 } // namespace
 
@@ -134,21 +229,8 @@ QImage ConvertFrame(
 	const auto format = AV_PIX_FMT_BGRA;
 	const auto hasDesiredFormat = (frame->format == format);
 	if (frameSize == storage.size() && hasDesiredFormat) {
-		static_assert(sizeof(uint32) == FFmpeg::kPixelBytesSize);
-		auto to = reinterpret_cast<uint32*>(storage.bits());
-		auto from = reinterpret_cast<const uint32*>(frame->data[0]);
-		const auto deltaTo = (storage.bytesPerLine() / sizeof(uint32))
-			- storage.width();
-		const auto deltaFrom = (frame->linesize[0] / sizeof(uint32))
-			- frame->width;
-		for ([[maybe_unused]] const auto y : ranges::views::ints(0, frame->height)) {
-			for ([[maybe_unused]] const auto x : ranges::views::ints(0, frame->width)) {
-				// Wipe out possible alpha values.
-				*to++ = 0xFF000000U | *from++;
-			}
-			to += deltaTo;
-			from += deltaFrom;
-		}
+		// Wipe out possible alpha values.
+		FillAlpha(storage, frame);
 	} else {
 		stream.swscale = MakeSwscalePointer(
 			frame,
@@ -301,6 +383,14 @@ QImage PrepareByRequest(
 		storage = FFmpeg::CreateFrameStorage(outer);
 	}
 
+	if (CopyGoodForRequest(original, alpha, rotation, request)) {
+		// The frame was already scaled to the target size in ConvertFrame,
+		// so only the rounding mask is left to apply, skip QPainter pass.
+		CopyFrameImage(storage, original);
+		ApplyFrameRounding(storage, request);
+		return storage;
+	}
+
 	QPainter p(&storage);
 	PaintFrameContent(p, original, alpha, rotation, request);
 	p.end();
@@ -101,6 +101,7 @@ public:
 		const Instance *instance,
 		const FrameRequest &request);
 	void removeFrameRequest(const Instance *instance);
+	void updateDecodeQuality();
 
 	void rasterizeFrame(not_null<Frame*> frame);
 	[[nodiscard]] bool requireARGB32() const;
@@ -160,6 +161,7 @@ private:
 	rpl::event_stream<> _checkNextFrame;
 	rpl::event_stream<> _waitingForData;
 	base::flat_map<const Instance*, FrameRequest> _requests;
+	FFmpeg::DecodeQuality _decodeQuality = FFmpeg::DecodeQuality::Full;
 
 	bool _queued = false;
 	base::ConcurrentTimer _readFramesTimer;
@@ -566,10 +568,33 @@ void VideoTrackObject::updateFrameRequest(
 		const Instance *instance,
 		const FrameRequest &request) {
 	_requests[instance] = request;
+	updateDecodeQuality();
 }
 
 void VideoTrackObject::removeFrameRequest(const Instance *instance) {
 	_requests.remove(instance);
+	updateDecodeQuality();
+}
+
+void VideoTrackObject::updateDecodeQuality() {
+	if (!_stream.codec) {
+		return;
+	}
+	auto display = QSize();
+	for (const auto &[_, request] : _requests) {
+		if (!request.preview || request.resize.isEmpty()) {
+			display = QSize();
+			break;
+		}
+		display = display.expandedTo(request.resize);
+	}
+	const auto quality = FFmpeg::ChooseDecodeQuality(
+		QSize(_stream.codec->width, _stream.codec->height),
+		display);
+	if (_decodeQuality != quality) {
+		_decodeQuality = quality;
+		FFmpeg::SetDecodeQuality(_stream.codec.get(), quality);
+	}
 }
 
 bool VideoTrackObject::tryReadFirstFrame(FFmpeg::Packet &&packet) {
@@ -0,0 +1,146 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "mtproto/details/mtproto_requests_registry.h"
+
+namespace MTP::details {
+
+bool RequestsRegistry::Record::empty() const {
+	return !request && !handler.done && !handler.fail && !shiftedDcId;
+}
+
+auto RequestsRegistry::shard(mtpRequestId requestId) -> Shard & {
+	// Request ids are sequential, so neighbours go to different shards.
+	return _shards[uint32(requestId) % kShardsCount];
+}
+
+auto RequestsRegistry::shard(mtpRequestId requestId) const -> const Shard & {
+	return _shards[uint32(requestId) % kShardsCount];
+}
+
+void RequestsRegistry::RemoveIfEmpty(Records &records, Records::iterator i) {
+	if (i->second.empty()) {
+		records.erase(i);
+	}
+}
+
+void RequestsRegistry::store(
+		mtpRequestId requestId,
+		const SerializedRequest &request,
+		ResponseHandler &&handler) {
+	auto &data = shard(requestId);
+	QMutexLocker lock(&data.mutex);
+	auto &record = data.records[requestId];
+	record.request = request;
+	if (handler.done || handler.fail) {
+		record.handler = std::move(handler);
+	}
+}
+
+SerializedRequest RequestsRegistry::request(mtpRequestId requestId) const {
+	const auto &data = shard(requestId);
+	QMutexLocker lock(&data.mutex);
+	const auto i = data.records.find(requestId);
+	return (i != data.records.end()) ? i->second.request : SerializedRequest();
+}
+
+SerializedRequest RequestsRegistry::takeRequest(mtpRequestId requestId) {
+	auto &data = shard(requestId);
+	QMutexLocker lock(&data.mutex);
+	const auto i = data.records.find(requestId);
+	if (i == data.records.end()) {
+		return SerializedRequest();
+	}
+	auto result = base::take(i->second.request);
+	RemoveIfEmpty(data.records, i);
+	return result;
+}
+
+void RequestsRegistry::registerDc(
+		mtpRequestId requestId,
+		ShiftedDcId shiftedDcId) {
+	auto &data = shard(requestId);
+	QMutexLocker lock(&data.mutex);
+	data.records[requestId].shiftedDcId = shiftedDcId;
+}
+
+std::optional<ShiftedDcId> RequestsRegistry::queryDc(
+		mtpRequestId requestId) const {
+	const auto &data = shard(requestId);
+	QMutexLocker lock(&data.mutex);
+	const auto i = data.records.find(requestId);
+	return (i != data.records.end()) ? i->second.shiftedDcId : std::nullopt;
+}
+
+std::optional<ShiftedDcId> RequestsRegistry::changeDc(
+		mtpRequestId requestId,
+		DcId newdc) {
+	auto &data = shard(requestId);
+	QMutexLocker lock(&data.mutex);
+	const auto i = data.records.find(requestId);
+	if (i == data.records.end() || !i->second.shiftedDcId) {
+		return std::nullopt;
+	}
+	auto &shiftedDcId = *i->second.shiftedDcId;
+	if (shiftedDcId < 0) {
+		shiftedDcId = -newdc;
+	} else {
+		shiftedDcId = ShiftDcId(newdc, GetDcIdShift(shiftedDcId));
+	}
+	return shiftedDcId;
+}
+
+void RequestsRegistry::unregister(mtpRequestId requestId) {
+	auto &data = shard(requestId);
+	QMutexLocker lock(&data.mutex);
+	const auto i = data.records.find(requestId);
+	if (i != data.records.end()) {
+		i->second.request = SerializedRequest();
+		i->second.shiftedDcId = std::nullopt;
+		RemoveIfEmpty(data.records, i);
+	}
+}
+
+bool RequestsRegistry::hasHandler(mtpRequestId requestId) const {
+	const auto &data = shard(requestId);
+	QMutexLocker lock(&data.mutex);
+	const auto i = data.records.find(requestId);
+	return (i != data.records.end())
+		&& (i->second.handler.done || i->second.handler.fail);
+}
+
+ResponseHandler RequestsRegistry::takeHandler(mtpRequestId requestId) {
+	auto &data = shard(requestId);
+	QMutexLocker lock(&data.mutex);
+	const auto i = data.records.find(requestId);
+	if (i == data.records.end()) {
+		return ResponseHandler();
+	}
+	auto result = base::take(i->second.handler);
+	RemoveIfEmpty(data.records, i);
+	return result;
+}
+
+void RequestsRegistry::restoreHandler(
+		mtpRequestId requestId,
+		ResponseHandler &&handler) {
+	auto &data = shard(requestId);
+	QMutexLocker lock(&data.mutex);
+	data.records[requestId].handler = std::move(handler);
+}
+
+void RequestsRegistry::removeHandler(mtpRequestId requestId) {
+	auto &data = shard(requestId);
+	QMutexLocker lock(&data.mutex);
+	const auto i = data.records.find(requestId);
+	if (i != data.records.end()) {
+		i->second.handler = ResponseHandler();
+		RemoveIfEmpty(data.records, i);
+	}
+}
+
+} // namespace MTP::details
@@ -0,0 +1,67 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "mtproto/details/mtproto_serialized_request.h"
+#include "mtproto/mtproto_response.h"
+#include "base/flat_map.h"
+
+#include <QtCore/QMutex>
+
+namespace MTP::details {
+
+// All the per-request state of MTP::Instance, sharded by request id,
+// so that session threads sending different requests rarely contend.
+class RequestsRegistry final {
+public:
+	void store(
+		mtpRequestId requestId,
+		const SerializedRequest &request,
+		ResponseHandler &&handler);
+	[[nodiscard]] SerializedRequest request(mtpRequestId requestId) const;
+	[[nodiscard]] SerializedRequest takeRequest(mtpRequestId requestId);
+
+	void registerDc(mtpRequestId requestId, ShiftedDcId shiftedDcId);
+	[[nodiscard]] std::optional<ShiftedDcId> queryDc(
+		mtpRequestId requestId) const;
+	std::optional<ShiftedDcId> changeDc(mtpRequestId requestId, DcId newdc);
+
+	// Removes the request and its dc, but leaves the handler.
+	void unregister(mtpRequestId requestId);
+
+	[[nodiscard]] bool hasHandler(mtpRequestId requestId) const;
+	[[nodiscard]] ResponseHandler takeHandler(mtpRequestId requestId);
+	void restoreHandler(mtpRequestId requestId, ResponseHandler &&handler);
+	void removeHandler(mtpRequestId requestId);
+
+private:
+	static constexpr auto kShardsCount = 16;
+
+	struct Record {
+		SerializedRequest request;
+		ResponseHandler handler;
+		std::optional<ShiftedDcId> shiftedDcId;
+
+		[[nodiscard]] bool empty() const;
+	};
+	using Records = base::flat_map<mtpRequestId, Record>;
+
+	struct Shard {
+		mutable QMutex mutex;
+		Records records;
+	};
+
+	[[nodiscard]] Shard &shard(mtpRequestId requestId);
+	[[nodiscard]] const Shard &shard(mtpRequestId requestId) const;
+	static void RemoveIfEmpty(Records &records, Records::iterator i);
+
+	std::array<Shard, kShardsCount> _shards;
+
+};
+
+} // namespace MTP::details
@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/mtp_instance.h"
 
 #include "mtproto/details/mtproto_dcenter.h"
+#include "mtproto/details/mtproto_requests_registry.h"
 #include "mtproto/details/mtproto_rsa_public_key.h"
 #include "mtproto/special_config_request.h"
 #include "mtproto/session.h"
@@ -34,6 +35,9 @@ namespace {
 constexpr auto kConfigBecomesOldIn = 2 * 60 * crl::time(1000);
 constexpr auto kConfigBecomesOldForBlockedIn = 8 * crl::time(1000);
 
+// Log responses which parsing and handling blocks the main thread longer.
+constexpr auto kSlowResponseHandleDuration = crl::time(16);
+
 using namespace details;
 
 std::atomic<int> GlobalAtomicRequestId = 0;
@@ -252,19 +256,13 @@ private:
 	rpl::event_stream<> _writeKeysRequests;
 	rpl::event_stream<> _allKeysDestroyed;
 
-	// holds dcWithShift for request to this dc or -dc for request to main dc
-	std::map<mtpRequestId, ShiftedDcId> _requestsByDc;
-	mutable QMutex _requestByDcLock;
+	// holds request data, response handler and dcWithShift
+	// for request to this dc or -dc for request to main dc
+	RequestsRegistry _requests;
 
 	// holds target dcWithShift for auth export request
 	std::map<mtpRequestId, ShiftedDcId> _authExportRequests;
 
-	std::map<mtpRequestId, ResponseHandler> _parserMap;
-	mutable QMutex _parserMapLock;
-
-	std::map<mtpRequestId, SerializedRequest> _requestMap;
-	QReadWriteLock _requestMapLock;
-
 	std::deque<std::pair<mtpRequestId, crl::time>> _delayedRequests;
 	base::flat_map<mtpRequestId, mtpRequestId> _dependentRequests;
 	mutable QMutex _dependentRequestsLock;
@@ -634,22 +632,15 @@ void Instance::Private::cancel(mtpRequestId requestId) {
 	DEBUG_LOG(("MTP Info: Cancel request %1.").arg(requestId));
 	const auto shiftedDcId = queryRequestByDc(requestId);
 	auto msgId = mtpMsgId(0);
-	{
-		QWriteLocker locker(&_requestMapLock);
-		auto it = _requestMap.find(requestId);
-		if (it != _requestMap.end()) {
-			msgId = *(mtpMsgId*)(it->second->constData() + 4);
-			_requestMap.erase(it);
-		}
+	if (const auto request = _requests.takeRequest(requestId)) {
+		msgId = *(mtpMsgId*)(request->constData() + 4);
 	}
 	unregisterRequest(requestId);
 	if (shiftedDcId) {
 		const auto session = getSession(qAbs(*shiftedDcId));
 		session->cancel(requestId, msgId);
 	}
-
-	QMutexLocker locker(&_parserMapLock);
-	_parserMap.erase(requestId);
+	_requests.removeHandler(requestId);
 }
 
 // result < 0 means waiting for such count of ms.
@@ -920,28 +911,13 @@ bool Instance::Private::configLoadFail(const Error &error) {
 
 std::optional<ShiftedDcId> Instance::Private::queryRequestByDc(
 		mtpRequestId requestId) const {
-	QMutexLocker locker(&_requestByDcLock);
-	auto it = _requestsByDc.find(requestId);
-	if (it != _requestsByDc.cend()) {
-		return it->second;
-	}
-	return std::nullopt;
+	return _requests.queryDc(requestId);
 }
 
 std::optional<ShiftedDcId> Instance::Private::changeRequestByDc(
 		mtpRequestId requestId,
 		DcId newdc) {
-	QMutexLocker locker(&_requestByDcLock);
-	auto it = _requestsByDc.find(requestId);
-	if (it != _requestsByDc.cend()) {
-		if (it->second < 0) {
-			it->second = -newdc;
-		} else {
-			it->second = ShiftDcId(newdc, GetDcIdShift(it->second));
-		}
-		return it->second;
-	}
-	return std::nullopt;
+	return _requests.changeDc(requestId, newdc);
 }
 
 void Instance::Private::checkDelayedRequests() {
@@ -958,15 +934,10 @@ void Instance::Private::checkDelayedRequests() {
 			continue;
 		}
 
-		auto request = SerializedRequest();
-		{
-			QReadLocker locker(&_requestMapLock);
-			auto it = _requestMap.find(requestId);
-			if (it == _requestMap.cend()) {
-				DEBUG_LOG(("MTP Error: could not find request %1").arg(requestId));
-				continue;
-			}
-			request = it->second;
+		const auto request = _requests.request(requestId);
+		if (!request) {
+			DEBUG_LOG(("MTP Error: could not find request %1").arg(requestId));
+			continue;
 		}
 		const auto session = getSession(qAbs(dcWithShift));
 		session->sendPrepared(request);
@@ -1007,23 +978,14 @@ void Instance::Private::sendRequest(
 void Instance::Private::registerRequest(
 		mtpRequestId requestId,
 		ShiftedDcId shiftedDcId) {
-	QMutexLocker locker(&_requestByDcLock);
-	_requestsByDc[requestId] = shiftedDcId;
+	_requests.registerDc(requestId, shiftedDcId);
 }
 
 void Instance::Private::unregisterRequest(mtpRequestId requestId) {
 	DEBUG_LOG(("MTP Info: unregistering request %1.").arg(requestId));
 
 	_requestsDelays.erase(requestId);
-
-	{
-		QWriteLocker locker(&_requestMapLock);
-		_requestMap.erase(requestId);
-	}
-	{
-		QMutexLocker locker(&_requestByDcLock);
-		_requestsByDc.erase(requestId);
-	}
+	_requests.unregister(requestId);
 	{
 		auto toRemove = base::flat_set<mtpRequestId>();
 		auto toResend = base::flat_set<mtpRequestId>();
@@ -1050,15 +1012,10 @@ void Instance::Private::unregisterRequest(mtpRequestId requestId) {
 
 		for (const auto resendingId : toResend) {
 			if (const auto shiftedDcId = queryRequestByDc(resendingId)) {
-				SerializedRequest request;
-				{
-					QReadLocker locker(&_requestMapLock);
-					auto it = _requestMap.find(resendingId);
-					if (it == _requestMap.cend()) {
-						LOG(("MTP Error: could not find dependent request %1").arg(resendingId));
-						return;
-					}
-					request = it->second;
+				const auto request = _requests.request(resendingId);
+				if (!request) {
+					LOG(("MTP Error: could not find dependent request %1").arg(resendingId));
+					return;
 				}
 				getSession(qAbs(*shiftedDcId))->sendPrepared(request);
 			}
@@ -1070,48 +1027,23 @@ void Instance::Private::storeRequest(
 		mtpRequestId requestId,
 		const SerializedRequest &request,
 		ResponseHandler &&callbacks) {
-	if (callbacks.done || callbacks.fail) {
-		QMutexLocker locker(&_parserMapLock);
-		_parserMap.emplace(requestId, std::move(callbacks));
-	}
-	{
-		QWriteLocker locker(&_requestMapLock);
-		_requestMap.emplace(requestId, request);
-	}
+	_requests.store(requestId, request, std::move(callbacks));
 }
 
 SerializedRequest Instance::Private::getRequest(mtpRequestId requestId) {
-	auto result = SerializedRequest();
-	{
-		QReadLocker locker(&_requestMapLock);
-		auto it = _requestMap.find(requestId);
-		if (it != _requestMap.cend()) {
-			result = it->second;
-		}
-	}
-	return result;
+	return _requests.request(requestId);
 }
 
 bool Instance::Private::hasCallback(mtpRequestId requestId) const {
-	QMutexLocker locker(&_parserMapLock);
-	auto it = _parserMap.find(requestId);
-	return (it != _parserMap.cend());
+	return _requests.hasHandler(requestId);
 }
 
 void Instance::Private::processCallback(const Response &response) {
 	const auto requestId = response.requestId;
-	ResponseHandler handler;
-	{
-		QMutexLocker locker(&_parserMapLock);
-		auto it = _parserMap.find(requestId);
-		if (it != _parserMap.cend()) {
-			handler = std::move(it->second);
-			_parserMap.erase(it);
-
-			DEBUG_LOG(("RPC Info: found parser for request %1, trying to parse response...").arg(requestId));
-		}
-	}
+	auto handler = _requests.takeHandler(requestId);
 	if (handler.done || handler.fail) {
+		DEBUG_LOG(("RPC Info: found parser for request %1, trying to parse response...").arg(requestId));
+
 		const auto handleError = [&](const Error &error) {
 			DEBUG_LOG(("RPC Info: "
 				"error received, code %1, type %2, description: %3").arg(
@@ -1121,8 +1053,7 @@ void Instance::Private::processCallback(const Response &response) {
 			if (rpcErrorOccured(response, handler, error)) {
 				unregisterRequest(requestId);
 			} else {
-				QMutexLocker locker(&_parserMapLock);
-				_parserMap.emplace(requestId, std::move(handler));
+				_requests.restoreHandler(requestId, std::move(handler));
 			}
 		};
 
@@ -1140,11 +1071,20 @@ void Instance::Private::processCallback(const Response &response) {
 						"RESPONSE_PARSE_FAILED",
 						"Error parse failed.")));
 		} else {
+			const auto started = crl::now();
 			if (handler.done && !handler.done(response)) {
 				handleError(Error::Local(
 					"RESPONSE_PARSE_FAILED",
 					"Response parse failed."));
 			}
+			const auto duration = crl::now() - started;
+			if (duration >= kSlowResponseHandleDuration) {
+				DEBUG_LOG(("RPC Info: response %1 for request %2 handled "
+					"in %3 ms."
+					).arg(uint32(*from), 0, 16
+					).arg(requestId
+					).arg(duration));
+			}
 			unregisterRequest(requestId);
 		}
 	} else {
@@ -1223,10 +1163,9 @@ void Instance::Private::importDone(
 
 	auto &waiters = _authWaiters[newdc];
 	if (waiters.size()) {
-		QReadLocker locker(&_requestMapLock);
 		for (auto waitedRequestId : waiters) {
-			auto it = _requestMap.find(waitedRequestId);
-			if (it == _requestMap.cend()) {
+			const auto request = _requests.request(waitedRequestId);
+			if (!request) {
 				LOG(("MTP Error: could not find request %1 for resending").arg(waitedRequestId));
 				continue;
 			}
@@ -1239,7 +1178,7 @@ void Instance::Private::importDone(
 			}
 			DEBUG_LOG(("MTP Info: resending request %1 to dc %2 after import auth").arg(waitedRequestId).arg(*shiftedDcId));
 			const auto session = getSession(*shiftedDcId);
-			session->sendPrepared(it->second);
+			session->sendPrepared(request);
 		}
 		waiters.clear();
 	}
@@ -1374,15 +1313,10 @@ bool Instance::Private::onErrorDefault(
 			newdcWithShift = ShiftDcId(newdcWithShift, GetDcIdShift(dcWithShift));
 		}
 
-		auto request = SerializedRequest();
-		{
-			QReadLocker locker(&_requestMapLock);
-			auto it = _requestMap.find(requestId);
-			if (it == _requestMap.cend()) {
-				LOG(("MTP Error: could not find request %1").arg(requestId));
-				return false;
-			}
-			request = it->second;
+		auto request = _requests.request(requestId);
+		if (!request) {
+			LOG(("MTP Error: could not find request %1").arg(requestId));
+			return false;
 		}
 		const auto session = getSession(newdcWithShift);
 		registerRequest(
@@ -1391,15 +1325,10 @@ bool Instance::Private::onErrorDefault(
 		session->sendPrepared(request);
 		return true;
 	} else if (type == qstr("MSG_WAIT_TIMEOUT") || type == qstr("MSG_WAIT_FAILED")) {
-		SerializedRequest request;
-		{
-			QReadLocker locker(&_requestMapLock);
-			auto it = _requestMap.find(requestId);
-			if (it == _requestMap.cend()) {
-				LOG(("MTP Error: could not find MSG_WAIT_* request %1").arg(requestId));
-				return false;
-			}
-			request = it->second;
+		auto request = _requests.request(requestId);
+		if (!request) {
+			LOG(("MTP Error: could not find MSG_WAIT_* request %1").arg(requestId));
+			return false;
 		}
 		if (!request->after) {
 			LOG(("MTP Error: MSG_WAIT_* for not dependent request %1").arg(requestId));
@@ -1501,15 +1430,10 @@ bool Instance::Private::onErrorDefault(
 		return true;
 	} else if (type == qstr("CONNECTION_NOT_INITED")
 		|| type == qstr("CONNECTION_LAYER_INVALID")) {
-		SerializedRequest request;
-		{
-			QReadLocker locker(&_requestMapLock);
-			auto it = _requestMap.find(requestId);
-			if (it == _requestMap.cend()) {
-				LOG(("MTP Error: could not find request %1").arg(requestId));
-				return false;
-			}
-			request = it->second;
+		auto request = _requests.request(requestId);
+		if (!request) {
+			LOG(("MTP Error: could not find request %1").arg(requestId));
+			return false;
 		}
 		auto dcWithShift = ShiftedDcId(0);
 		if (const auto shiftedDcId = queryRequestByDc(requestId)) {
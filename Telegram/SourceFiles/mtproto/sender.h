@@ -8,13 +8,14 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "base/variant.h"
+#include "base/weak_ptr.h"
 #include "mtproto/mtproto_response.h"
 #include "mtproto/mtp_instance.h"
 #include "mtproto/facade.h"
 
 namespace MTP {
 
-class Sender {
+class Sender : public base::has_weak_ptr {
 	class RequestBuilder {
 	public:
 		RequestBuilder(const RequestBuilder &other) = delete;
@@ -36,6 +37,34 @@ class Sender {
 		static constexpr bool IsCallable
 			= rpl::details::is_callable_plain_v<Args...>;
 
+		template <typename Result, typename Handler>
+		static void InvokeDoneHandler(
+				Handler &handler,
+				const Result &result,
+				const Response &response) {
+			if (!handler) {
+				return;
+			} else if constexpr (IsCallable<
+					Handler,
+					const Result&,
+					const Response&>) {
+				handler(result, response);
+			} else if constexpr (IsCallable<
+					Handler,
+					const Result&,
+					mtpRequestId>) {
+				handler(result, response.requestId);
+			} else if constexpr (IsCallable<
+					Handler,
+					const Result&>) {
+				handler(result);
+			} else if constexpr (IsCallable<Handler>) {
+				handler();
+			} else {
+				static_assert(false_t(Handler{}), "Bad done handler.");
+			}
+		}
+
 		template <typename Result, typename Handler>
 		[[nodiscard]] DoneHandler MakeDoneHandler(
 				not_null<Sender*> sender,
@@ -49,27 +78,60 @@ class Sender {
 				auto from = response.reply.constData();
 				if (!result.read(from, from + response.reply.size())) {
 					return false;
-				} else if (!onstack) {
-					return true;
-				} else if constexpr (IsCallable<
-						Handler,
-						const Result&,
-						const Response&>) {
-					onstack(result, response);
-				} else if constexpr (IsCallable<
-						Handler,
-						const Result&,
-						mtpRequestId>) {
-					onstack(result, response.requestId);
-				} else if constexpr (IsCallable<
-						Handler,
-						const Result&>) {
-					onstack(result);
-				} else if constexpr (IsCallable<Handler>) {
-					onstack();
-				} else {
-					static_assert(false_t(Handler{}), "Bad done handler.");
 				}
+				InvokeDoneHandler(onstack, result, response);
+				return true;
+			};
+		}
+
+		// Parses the result in crl::async and calls the handler on main.
+		// The fail handler is filled in send() to report parse failures.
+		// The request stays registered until the result reaches main,
+		// so it still can be cancelled while the result is being parsed.
+		template <typename Result, typename Handler>
+		[[nodiscard]] DoneHandler MakeBackgroundDoneHandler(
+				not_null<Sender*> sender,
+				Handler &&handler,
+				std::shared_ptr<FailHandler> fail) {
+			return [
+				sender,
+				handler = std::forward<Handler>(handler),
+				fail = std::move(fail)
+			](const Response &response) mutable {
+				crl::async([
+					sender,
+					weak = base::make_weak(sender.get()),
+					handler = std::move(handler),
+					fail,
+					response
+				]() mutable {
+					auto result = Result();
+					auto from = response.reply.constData();
+					const auto parsed = result.read(
+						from,
+						from + response.reply.size());
+					crl::on_main(weak, [
+						sender,
+						handler = std::move(handler),
+						fail,
+						response,
+						result = std::move(result),
+						parsed
+					]() mutable {
+						const auto requestId = response.requestId;
+						if (!sender->senderRequestWaiting(requestId)) {
+							return;
+						}
+						sender->senderRequestHandled(requestId);
+						if (parsed) {
+							InvokeDoneHandler(handler, result, response);
+						} else if (*fail) {
+							(*fail)(Error::Local(
+								"RESPONSE_PARSE_FAILED",
+								"Response parse failed."), response);
+						}
+					});
+				});
 				return true;
 			};
 		}
@@ -146,6 +208,11 @@ class Sender {
 		void setAfter(mtpRequestId requestId) noexcept {
 			_afterRequestId = requestId;
 		}
+		void setParseInBackground() {
+			Expects(!_done);
+
+			_backgroundFail = std::make_shared<FailHandler>();
+		}
 
 		ShiftedDcId takeDcId() const noexcept {
 			return _dcId;
@@ -167,6 +234,9 @@ class Sender {
 		mtpRequestId takeAfter() const noexcept {
 			return _afterRequestId;
 		}
+		const std::shared_ptr<FailHandler> &backgroundFail() const noexcept {
+			return _backgroundFail;
+		}
 
 		not_null<Sender*> sender() const noexcept {
 			return _sender;
@@ -187,6 +257,7 @@ class Sender {
 			FailFullHandler> _fail;
 		FailSkipPolicy _failSkipPolicy = FailSkipPolicy::Simple;
 		mtpRequestId _afterRequestId = 0;
+		std::shared_ptr<FailHandler> _backgroundFail;
 
 	};
 
@@ -219,34 +290,37 @@ public:
 			return *this;
 		}
 
+		// Must be called before done(), the result is parsed in
+		// crl::async and the handler is called on main with it.
+		[[nodiscard]] SpecificRequestBuilder &parseInBackground() {
+			setParseInBackground();
+			return *this;
+		}
+
 		using Result = typename Request::ResponseType;
 		[[nodiscard]] SpecificRequestBuilder &done(
 			FnMut<void(
 				const Result &result,
 				mtpRequestId requestId)> callback) {
-			setDoneHandler(
-				MakeDoneHandler<Result>(sender(), std::move(callback)));
+			setDoneHandler(makeDoneHandler(std::move(callback)));
 			return *this;
 		}
 		[[nodiscard]] SpecificRequestBuilder &done(
 			FnMut<void(
 				const Result &result,
 				const Response &response)> callback) {
-			setDoneHandler(
-				MakeDoneHandler<Result>(sender(), std::move(callback)));
+			setDoneHandler(makeDoneHandler(std::move(callback)));
 			return *this;
 		}
 		[[nodiscard]] SpecificRequestBuilder &done(
 				FnMut<void()> callback) {
-			setDoneHandler(
-				MakeDoneHandler<Result>(sender(), std::move(callback)));
+			setDoneHandler(makeDoneHandler(std::move(callback)));
 			return *this;
 		}
 		[[nodiscard]] SpecificRequestBuilder &done(
 			FnMut<void(
 				const typename Request::ResponseType &result)> callback) {
-			setDoneHandler(
-				MakeDoneHandler<Result>(sender(), std::move(callback)));
+			setDoneHandler(makeDoneHandler(std::move(callback)));
 			return *this;
 		}
 
@@ -289,10 +363,14 @@ public:
 		}
 
 		mtpRequestId send() {
+			auto fail = takeOnFail();
+			if (const auto &slot = backgroundFail()) {
+				*slot = fail;
+			}
 			const auto id = sender()->_instance->send(
 				_request,
 				takeOnDone(),
-				takeOnFail(),
+				std::move(fail),
 				takeDcId(),
 				takeCanWait(),
 				takeAfter());
@@ -301,6 +379,19 @@ public:
 		}
 
 	private:
+		template <typename Handler>
+		[[nodiscard]] DoneHandler makeDoneHandler(Handler &&handler) {
+			if (const auto &fail = backgroundFail()) {
+				return MakeBackgroundDoneHandler<Result>(
+					sender(),
+					std::forward<Handler>(handler),
+					fail);
+			}
+			return MakeDoneHandler<Result>(
+				sender(),
+				std::forward<Handler>(handler));
+		}
+
 		Request _request;
 
 	};
@@ -433,6 +524,9 @@ private:
 			_requests.erase(it);
 		}
 	}
+	[[nodiscard]] bool senderRequestWaiting(mtpRequestId requestId) const {
+		return _requests.contains(requestId);
+	}
 	void senderRequestCancel(mtpRequestId requestId) {
 		auto it = _requests.find(requestId);
 		if (it != _requests.cend()) {
@@ -81,7 +81,7 @@ public:
 	base::flat_map<mtpRequestId, SerializedRequest> &toSendMap() {
 		return _toSend;
 	}
-	base::flat_map<mtpMsgId, SerializedRequest> &haveSentMap() {
+	std::unordered_map<mtpMsgId, SerializedRequest> &haveSentMap() {
 		return _haveSent;
 	}
 	std::vector<Response> &haveReceivedMessages() {
@@ -122,7 +122,7 @@ private:
 	base::flat_map<mtpRequestId, SerializedRequest> _toSend; // map of request_id -> request, that is waiting to be sent
 	QReadWriteLock _toSendLock;
 
-	base::flat_map<mtpMsgId, SerializedRequest> _haveSent; // map of msg_id -> request, that was sent
+	std::unordered_map<mtpMsgId, SerializedRequest> _haveSent; // map of msg_id -> request, that was sent
 	QReadWriteLock _haveSentLock;
 
 	std::vector<Response> _receivedMessages; // list of responses / updates that should be processed in the main thread
@@ -60,6 +60,14 @@ constexpr auto kSendStateRequestWaiting = crl::time(1000);
 // How much time to wait for some more requests, when sending msg acks.
 constexpr auto kAckSendWaiting = 10 * crl::time(1000);
 
+// Server accepts up to 1024 messages in a container,
+// leave some place for the service messages.
+constexpr auto kMaxContainerRequests = 1000;
+
+// Don't pack more than that in one container, so that a burst of requests
+// goes in several packets and the first responses don't wait for the rest.
+constexpr auto kMaxContainerRequestsSize = 64 * 1024 / kIntSize;
+
 auto SyncTimeRequestDuration = kFastRequestDuration;
 
 using namespace details;
@@ -95,7 +103,7 @@ using namespace details;
 void WrapInvokeAfter(
 		SerializedRequest &to,
 		const SerializedRequest &from,
-		const base::flat_map<mtpMsgId, SerializedRequest> &haveSent,
+		const std::unordered_map<mtpMsgId, SerializedRequest> &haveSent,
 		int32 skipBeforeRequest = 0) {
 	const auto afterId = *(mtpMsgId*)(from->after->data() + 4);
 	const auto i = afterId ? haveSent.find(afterId) : haveSent.end();
@@ -119,6 +127,30 @@ void WrapInvokeAfter(
 	}
 }
 
+// Takes from toSend as many requests as fit in one container.
+[[nodiscard]] std::vector<SerializedRequest> TakeContainerRequests(
+		base::flat_map<mtpRequestId, SerializedRequest> &toSend,
+		int32 initSizeInInts) {
+	auto result = std::vector<SerializedRequest>();
+	auto size = 0;
+	auto i = begin(toSend);
+	for (const auto e = end(toSend); i != e; ++i) {
+		const auto &request = i->second;
+		const auto add = int(request.messageSize())
+			+ (request->after ? 3 : 0)
+			+ ((initSizeInInts && request->needsLayer) ? initSizeInInts : 0);
+		if (!result.empty()
+			&& (int(result.size()) == kMaxContainerRequests
+				|| size + add > kMaxContainerRequestsSize)) {
+			break;
+		}
+		size += add;
+		result.push_back(request);
+	}
+	toSend.erase(begin(toSend), i);
+	return result;
+}
+
 [[nodiscard]] bool ConstTimeIsDifferent(
 		const void *a,
 		const void *b,
@@ -693,17 +725,21 @@ void SessionPrivate::tryToSend() {
 	}
 
 	bool needAnyResponse = false;
+	bool haveMoreToSend = false;
 	SerializedRequest toSendRequest;
 	{
 		QWriteLocker locker1(_sessionData->toSendMutex());
 
 		auto scheduleCheckSentRequests = false;
 
-		auto toSendDummy = base::flat_map<mtpRequestId, SerializedRequest>();
-		auto &toSend = sendAll
-			? _sessionData->toSendMap()
-			: toSendDummy;
-		if (!sendAll) {
+		auto toSend = std::vector<SerializedRequest>();
+		if (sendAll) {
+			auto &all = _sessionData->toSendMap();
+			toSend = TakeContainerRequests(
+				all,
+				needsLayer ? initSizeInInts : 0);
+			haveMoreToSend = !all.empty();
+		} else {
 			locker1.unlock();
 		}
 
@@ -731,11 +767,10 @@ void SessionPrivate::tryToSend() {
 			? httpWaitRequest
 			: bindDcKeyRequest
 			? bindDcKeyRequest
-			: toSend.begin()->second;
+			: toSend.front();
 		if (toSendCount == 1 && !first->forceSendInContainer) {
 			toSendRequest = first;
 			if (sendAll) {
-				toSend.clear();
 				locker1.unlock();
 			}
 
@@ -804,7 +839,7 @@ void SessionPrivate::tryToSend() {
 			if (stateRequest) containerSize += stateRequest.messageSize();
 			if (httpWaitRequest) containerSize += httpWaitRequest.messageSize();
 			if (bindDcKeyRequest) containerSize += bindDcKeyRequest.messageSize();
-			for (const auto &[requestId, request] : toSend) {
+			for (const auto &request : toSend) {
 				containerSize += request.messageSize();
 				if (needsLayer && request->needsLayer) {
 					containerSize += initSizeInInts;
@@ -855,7 +890,7 @@ void SessionPrivate::tryToSend() {
 				needAnyResponse = true;
 			}
 
-			for (auto &[requestId, request] : toSend) {
+			for (auto &request : toSend) {
 				const auto msgId = prepareToSend(
 					request,
 					bigMsgId,
@@ -900,7 +935,6 @@ void SessionPrivate::tryToSend() {
 					memcpy(toSendRequest->data() + from, request->constData() + 4, len * sizeof(mtpPrime));
 				}
 			}
-			toSend.clear();
 
 			if (stateRequest) {
 				const auto msgId = placeToContainer(
@@ -941,12 +975,22 @@ void SessionPrivate::tryToSend() {
 				forceNewMsgId);
 			_sentContainers.emplace(containerMsgId, std::move(sentIdsWrap));
 
+			DEBUG_LOG(("MTP Info: dc %1 sending container, "
+				"messages: %2, size: %3, more requests: %4"
+				).arg(_shiftedDcId
+				).arg(toSendCount
+				).arg(toSendRequest->size() * kIntSize
+				).arg(Logs::b(haveMoreToSend)));
+
 			if (scheduleCheckSentRequests && !_checkSentRequestsTimer.isActive()) {
 				_checkSentRequestsTimer.callOnce(kCheckSentRequestTimeout);
 			}
 		}
 	}
 	sendSecureRequest(std::move(toSendRequest), needAnyResponse);
+	if (haveMoreToSend) {
+		_sessionData->queueSendAnything();
+	}
 }
 
 void SessionPrivate::retryByTimer() {
@@ -1848,13 +1892,12 @@ SessionPrivate::HandleResult SessionPrivate::handleOneReceived(
 			const auto &haveSent = _sessionData->haveSentMap();
 			toResend.reserve(haveSent.size());
 			for (const auto &[msgId, request] : haveSent) {
-				if (msgId >= firstMsgId) {
-					break;
-				} else if (request->requestId) {
+				if (msgId < firstMsgId && request->requestId) {
 					toResend.push_back(msgId);
 				}
 			}
 		}
+		ranges::sort(toResend);
 		for (const auto msgId : toResend) {
 			resend(msgId, 10);
 		}
@@ -2225,8 +2268,21 @@ void SessionPrivate::resend(mtpMsgId msgId, crl::time msCanWait) {
 
 void SessionPrivate::resendAll() {
 	auto lock = QWriteLocker(_sessionData->haveSentMutex());
-	auto haveSent = base::take(_sessionData->haveSentMap());
+	auto haveSent = std::vector<std::pair<mtpMsgId, SerializedRequest>>();
+	{
+		auto &map = _sessionData->haveSentMap();
+		haveSent.reserve(map.size());
+		for (auto &[msgId, request] : map) {
+			haveSent.emplace_back(msgId, std::move(request));
+		}
+		map.clear();
+	}
 	lock.unlock();
+
+	// Resend in the original order, it also keeps toSend inserts cheap.
+	ranges::sort(haveSent, ranges::less(), [](const auto &pair) {
+		return pair.first;
+	});
 	{
 		auto lock = QWriteLocker(_sessionData->toSendMutex());
 		auto &toSend = _sessionData->toSendMap();
@@ -30,6 +30,8 @@ constexpr auto kMaxTrackedSuccesses = kRetryAddSessionSuccesses
 constexpr auto kRemoveSessionAfterTimeouts = 4;
 constexpr auto kResetDownloadPrioritiesTimeout = crl::time(200);
 constexpr auto kBadRequestDurationThreshold = 8 * crl::time(1000);
+constexpr auto kStatsPeriod = 10 * crl::time(1000);
+constexpr auto kStatsDurationsLimit = 1024;
 
 // Each (session remove by timeouts) we wait for time:
 // kRetryAddSessionTimeout * max(removesCount, kMaxTrackedSessionRemoves)
@@ -228,7 +230,8 @@ void DownloadManagerMtproto::requestSucceeded(
 		MTP::DcId dcId,
 		int index,
 		int amountAtRequestStart,
-		crl::time timeAtRequestStart) {
+		crl::time timeAtRequestStart,
+		int receivedBytes) {
 	using namespace rpl::mappers;
 
 	const auto i = _balanceData.find(dcId);
@@ -246,6 +249,7 @@ void DownloadManagerMtproto::requestSucceeded(
 		).arg(duration
 		).arg(parts
 		).arg(overloaded ? " (overloaded)" : ""));
+	accumulateStats(dcId, dc, duration, receivedBytes);
 	if (overloaded) {
 		return;
 	}
@@ -296,6 +300,50 @@ void DownloadManagerMtproto::requestSucceeded(
 		).arg(dc.sessions.size()));
 }
 
+void DownloadManagerMtproto::accumulateStats(
+		MTP::DcId dcId,
+		DcBalanceData &dc,
+		crl::time duration,
+		int receivedBytes) {
+	if (!Logs::DebugEnabled()) {
+		return;
+	}
+	const auto now = crl::now();
+	if (!dc.statsStart) {
+		dc.statsStart = now;
+	}
+	++dc.statsRequests;
+	dc.statsBytes += receivedBytes;
+	if (dc.statsDurations.size() < kStatsDurationsLimit) {
+		dc.statsDurations.push_back(duration);
+	} else {
+		dc.statsDurations[dc.statsDurationsIndex] = duration;
+		dc.statsDurationsIndex = (dc.statsDurationsIndex + 1)
+			% kStatsDurationsLimit;
+	}
+	const auto period = now - dc.statsStart;
+	if (period < kStatsPeriod) {
+		return;
+	}
+	auto &durations = dc.statsDurations;
+	const auto p99 = begin(durations) + (durations.size() * 99 / 100);
+	std::nth_element(begin(durations), p99, end(durations));
+
+	DEBUG_LOG(("Download (%1) stats: "
+		"%2 requests/sec, %3 KB/s, p99 duration: %4, sessions: %5"
+		).arg(dcId
+		).arg(dc.statsRequests * 1000. / period, 0, 'f', 1
+		).arg(dc.statsBytes * 1000 / (period * 1024)
+		).arg(*p99
+		).arg(dc.sessions.size()));
+
+	dc.statsStart = now;
+	dc.statsRequests = 0;
+	dc.statsBytes = 0;
+	dc.statsDurationsIndex = 0;
+	durations.clear();
+}
+
 int DownloadManagerMtproto::chooseSessionIndex(MTP::DcId dcId) const {
 	const auto i = _balanceData.find(dcId);
 	Assert(i != end(_balanceData));
@@ -603,9 +651,16 @@ void DownloadMtprotoTask::requestMoreCdnFileHashes() {
 void DownloadMtprotoTask::normalPartLoaded(
 		const MTPupload_File &result,
 		mtpRequestId requestId) {
+	const auto receivedBytes = result.match([](
+			const MTPDupload_file &data) {
+		return int(data.vbytes().v.size());
+	}, [](const MTPDupload_fileCdnRedirect &) {
+		return 0;
+	});
 	const auto requestData = finishSentRequest(
 		requestId,
-		FinishRequestReason::Success);
+		FinishRequestReason::Success,
+		receivedBytes);
 	const auto owner = _owner;
 	const auto dcId = this->dcId();
 	result.match([&](const MTPDupload_fileCdnRedirect &data) {
@@ -623,7 +678,8 @@ void DownloadMtprotoTask::webPartLoaded(
 		mtpRequestId requestId) {
 	const auto requestData = finishSentRequest(
 		requestId,
-		FinishRequestReason::Success);
+		FinishRequestReason::Success,
+		result.c_upload_webFile().vbytes().v.size());
 	const auto owner = _owner;
 	const auto dcId = this->dcId();
 	result.match([&](const MTPDupload_webFile &data) {
@@ -656,7 +712,8 @@ void DownloadMtprotoTask::cdnPartLoaded(const MTPupload_CdnFile &result, mtpRequ
 	}, [&](const MTPDupload_cdnFile &data) {
 		const auto requestData = finishSentRequest(
 			requestId,
-			FinishRequestReason::Success);
+			FinishRequestReason::Success,
+			data.vbytes().v.size());
 		const auto owner = _owner;
 		const auto dcId = this->dcId();
 		const auto guard = gsl::finally([=] {
@@ -799,7 +856,8 @@ void DownloadMtprotoTask::placeSentRequest(
 
 auto DownloadMtprotoTask::finishSentRequest(
 	mtpRequestId requestId,
-	FinishRequestReason reason)
+	FinishRequestReason reason,
+	int receivedBytes)
 -> RequestData {
 	auto it = _sentRequests.find(requestId);
 	Assert(it != _sentRequests.cend());
@@ -820,7 +878,8 @@ auto DownloadMtprotoTask::finishSentRequest(
 			dcId(),
 			result.sessionIndex,
 			result.requestedInSession,
-			result.sent);
+			result.sent,
+			receivedBytes);
 	}
 
 	Ensures(ok);
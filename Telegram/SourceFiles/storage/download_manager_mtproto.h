@@ -53,7 +53,8 @@ public:
 		MTP::DcId dcId,
 		int index,
 		int amountAtRequestStart,
-		crl::time timeAtRequestStart);
+		crl::time timeAtRequestStart,
+		int receivedBytes);
 	void checkSendNextAfterSuccess(MTP::DcId dcId);
 	[[nodiscard]] int chooseSessionIndex(MTP::DcId dcId) const;
 
@@ -91,6 +92,13 @@ private:
 		int sessionRemoveTimes = 0;
 		int timeouts = 0; // Since all sessions had successes >= required.
 		int totalRequested = 0;
+
+		// Throughput statistics, only collected with debug logs enabled.
+		crl::time statsStart = 0;
+		int statsRequests = 0;
+		int64 statsBytes = 0;
+		std::vector<crl::time> statsDurations; // Last requests ring buffer.
+		int statsDurationsIndex = 0;
 	};
 
 	void checkSendNext();
@@ -103,6 +111,11 @@ private:
 	void killSessions(MTP::DcId dcId);
 
 	void resetGeneration();
+	void accumulateStats(
+		MTP::DcId dcId,
+		DcBalanceData &dc,
+		crl::time duration,
+		int receivedBytes);
 	void sessionTimedOut(MTP::DcId dcId, int index);
 	void removeSession(MTP::DcId dcId);
 
@@ -235,7 +248,8 @@ private:
 		const RequestData &requestData);
 	[[nodiscard]] RequestData finishSentRequest(
 		mtpRequestId requestId,
-		FinishRequestReason reason);
+		FinishRequestReason reason,
+		int receivedBytes = 0);
 	void switchToCDN(
 		const RequestData &requestData,
 		const MTPDupload_fileCdnRedirect &redirect);
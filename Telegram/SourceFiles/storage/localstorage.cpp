@@ -49,6 +49,7 @@ constexpr auto kSavedBackgroundFormat = QImage::Format_ARGB32_Premultiplied;
 constexpr auto kWallPaperLegacySerializeTagId = int32(-111);
 constexpr auto kWallPaperSerializeTagId = int32(-112);
 constexpr auto kWallPaperSidesLimit = 10'000;
+constexpr auto kWaveformSizeLimit = 1024;
 
 const auto kThemeNewPathRelativeTag = qstr("special://new_tag");
 
@@ -799,6 +800,21 @@ int32 oldSettingsVersion() {
 	return _oldSettingsVersion;
 }
 
+[[nodiscard]] QByteArray SerializeWaveform(const VoiceWaveform &waveform) {
+	return QByteArray(
+		reinterpret_cast<const char*>(waveform.constData()),
+		waveform.size());
+}
+
+[[nodiscard]] VoiceWaveform DeserializeWaveform(const QByteArray &bytes) {
+	auto result = VoiceWaveform();
+	if (bytes.size() > 1 && bytes.size() <= kWaveformSizeLimit) {
+		result.resize(bytes.size());
+		memcpy(result.data(), bytes.constData(), bytes.size());
+	}
+	return result;
+}
+
 class CountWaveformTask : public Task {
 public:
 	CountWaveformTask(not_null<Data::DocumentMedia*> media)
@@ -823,6 +839,9 @@ public:
 			if (!_waveform.isEmpty()) {
 				voice->waveform = _waveform;
 				voice->wavemax = _wavemax;
+				_doc->owner().cache().putIfEmpty(
+					_doc->waveformCacheKey(),
+					SerializeWaveform(_waveform));
 			}
 			if (voice->waveform.isEmpty()) {
 				voice->waveform.resize(1);
@@ -850,17 +869,54 @@ protected:
 
 };
 
+void StartCountWaveformTask(not_null<Data::DocumentMedia*> media) {
+	const auto voice = media->owner()->voice();
+	Assert(voice != nullptr);
+
+	voice->waveform.resize(1 + sizeof(TaskId));
+	voice->waveform[0] = -1; // counting
+	TaskId taskId = _localLoader->addTask(
+		std::make_unique<CountWaveformTask>(media));
+	memcpy(voice->waveform.data() + 1, &taskId, sizeof(taskId));
+}
+
 void countVoiceWaveform(not_null<Data::DocumentMedia*> media) {
 	const auto document = media->owner();
-	if (const auto voice = document->voice()) {
-		if (_localLoader) {
-			voice->waveform.resize(1 + sizeof(TaskId));
-			voice->waveform[0] = -1; // counting
-			TaskId taskId = _localLoader->addTask(
-				std::make_unique<CountWaveformTask>(media));
-			memcpy(voice->waveform.data() + 1, &taskId, sizeof(taskId));
-		}
+	const auto voice = document->voice();
+	if (!voice || !_localLoader) {
+		return;
 	}
+	voice->waveform.resize(1);
+	voice->waveform[0] = -1; // looking in cache
+
+	// The waveform may be already counted for this document,
+	// so check the cache before decoding the whole file again.
+	const auto guard = base::make_weak(&document->session());
+	document->owner().cache().get(document->waveformCacheKey(), [=](
+			QByteArray value) {
+		crl::on_main(guard, [=] {
+			const auto voice = document->voice();
+			if (!voice
+				|| voice->waveform.size() != 1
+				|| voice->waveform[0] != -1) {
+				return;
+			}
+			auto waveform = DeserializeWaveform(value);
+			const auto media = waveform.isEmpty()
+				? document->activeMediaView()
+				: nullptr;
+			if (!waveform.isEmpty()) {
+				voice->wavemax = *ranges::max_element(waveform);
+				voice->waveform = std::move(waveform);
+				document->owner().requestDocumentViewRepaint(document);
+			} else if (media && _localLoader) {
+				StartCountWaveformTask(media.get());
+			} else {
+				// Count it again when it is painted next time.
+				voice->waveform.clear();
+			}
+		});
+	});
 }
 
 void cancelTask(TaskId id) {
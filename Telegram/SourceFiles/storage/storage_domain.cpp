@@ -250,6 +250,25 @@ bool Domain::checkPasscode(const QByteArray &passcode) const {
 	return checkKey->equals(_passcodeKey);
 }
 
+void Domain::checkPasscodeAsync(
+		const QByteArray &passcode,
+		Fn<void(bool correct)> done) const {
+	Expects(!_passcodeKeySalt.isEmpty());
+	Expects(_passcodeKey != nullptr);
+
+	crl::async([
+		=,
+		salt = _passcodeKeySalt,
+		passcodeKey = _passcodeKey
+	] {
+		const auto checkKey = CreateLocalKey(passcode, salt);
+		const auto correct = checkKey->equals(passcodeKey);
+		crl::on_main([=] {
+			done(correct);
+		});
+	});
+}
+
 void Domain::setPasscode(const QByteArray &passcode) {
 	Expects(!_passcodeKeySalt.isEmpty());
 	Expects(_localKey != nullptr);
@@ -400,6 +400,7 @@ void UserpicButton::paintUserpicFrame(Painter &p, QPoint photoPosition) {
 		request.outer = size * cIntRetinaFactor();
 		request.resize = size * cIntRetinaFactor();
 		request.radius = ImageRoundRadius::Ellipse;
+		request.preview = true;
 		p.drawImage(QRect(photoPosition, size), _streamed->frame(request));
 		if (!paused) {
 			_streamed->markFrameShown();
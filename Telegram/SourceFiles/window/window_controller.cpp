@@ -54,6 +54,7 @@ Controller::~Controller() {
 }
 
 void Controller::showAccount(not_null<Main::Account*> account) {
+	const auto started = crl::now();
 	const auto prevSessionUniqueId = (_account && _account->sessionExists())
 		? _account->session().uniqueId()
 		: 0;
@@ -114,6 +115,9 @@ void Controller::showAccount(not_null<Main::Account*> account) {
 
 		crl::on_main(updateOnlineOfPrevSesssion);
 	}, _accountLifetime);
+
+	DEBUG_LOG(("App Info: account shown in %1 ms."
+		).arg(crl::now() - started));
 }
 
 void Controller::checkLockByTerms() {